@@ -0,0 +1,30 @@
+#!/bin/bash
+# Convergence time and traffic of two-level cluster sync against one flat
+# group, for several group sizes. Every run appends one line per setting to
+# result2/cluster-traffic.txt:
+#   nodes flat converged_fraction convergence_ms traffic_per_node
+# where an object converged once 90% of the nodes have it, its convergence
+# time being from its publication to the last of those nodes, and the
+# traffic is the interests and data sent per node.
+for nodes in 100 200 500
+do
+  for flat in 0 1
+  do
+    echo "start simulation: $nodes nodes, flat=$flat"
+    rm -f snapshot.txt memory.txt fetch.txt delivery.txt cluster.txt
+    ./waf --run "sync-for-sleep-cluster --nodes=$nodes --flat=$flat" >/dev/null
+    converged=$(awk -F, -v n=$nodes '
+      $3 == "P" { published[$1] = $2; count[$1]++; if ($2 > last[$1]) last[$1] = $2 }
+      $3 == "R" { count[$1]++; if ($2 > last[$1]) last[$1] = $2 }
+      END {
+        for (o in published) {
+          total++
+          if (count[o] >= 0.9 * n) { done++; delay += last[o] - published[o] }
+        }
+        print (total ? done / total : 0), (done ? delay / done : 0)
+      }' delivery.txt)
+    # the heads write a second line for the backbone, which is traffic too
+    traffic=$(awk -F, -v n=$nodes '{ sent += $2 + $7 } END { print sent / n }' fetch.txt)
+    echo $nodes $flat $converged $traffic >> result2/cluster-traffic.txt
+  done
+done
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "sync-sleep-node.hpp"
+
+namespace ndn {
+namespace vsync {
+namespace sync_for_sleep {
+
+static const std::string clusterFileName = "cluster.txt";
+
+// a cluster head: a device in its cluster and in the backbone
+class ClusterHeadNode {
+ public:
+  ClusterHeadNode(const GroupID& gid, uint64_t cluster, uint64_t cluster_num, const NodeID& nid,
+                  const Name& prefix, uint64_t cluster_size, bool push = false,
+                  int data_rate_lower = 1000, int data_rate_upper = 8000, bool log_delivery = false)
+      : scheduler_(face_.getIoService()),
+        device_(face_, scheduler_, ns3::ndn::StackHelper::getKeyChain()),
+        head_(device_, prefix, gid, cluster, cluster_num, nid, cluster_size),
+        cluster_(cluster),
+        nid_(nid)
+        {
+          Node& node = head_.GetClusterNode();
+          node.SetPush(push);
+          node.SetPublishRate(data_rate_lower, data_rate_upper);
+          head_.GetBackboneNode().SetPush(push);
+          // the relays into the cluster are the objects of the other clusters
+          if (log_delivery) {
+            node.SetNewDataCallback([this] (NodeID nid, uint64_t, const Data& data) {
+              delivery_log_.Record(nid_, nid, data);
+            });
+          }
+        }
+
+  void Start() {
+  }
+
+  void Stop() {
+    // one fetch line per group of the head
+    std::ofstream fetch_out;
+    fetch_out.open(fetchFileName, std::ofstream::out | std::ofstream::app);
+    if (fetch_out.is_open()) {
+      WriteFetchStats(fetch_out, nid_, head_.GetClusterNode());
+      WriteFetchStats(fetch_out, cluster_, head_.GetBackboneNode());
+    }
+    else {
+      std::cout << "Fail to write files" << std::endl;
+    }
+
+    // heads: "cluster,relayed_up,relayed_down,radio_wakeups,radio_wakeups_saved,radio_sleeping_time"
+    std::ofstream cluster_out;
+    cluster_out.open(clusterFileName, std::ofstream::out | std::ofstream::app);
+    if (cluster_out.is_open()) {
+      cluster_out << cluster_ << "," << head_.GetRelayedUpNum() << "," << head_.GetRelayedDownNum() << ","
+                  << device_.GetRadioWakeupNum() << "," << device_.GetRadioWakeupSavedNum() << ","
+                  << device_.GetRadioSleepingTime() << "\n";
+    }
+    else {
+      std::cout << "Fail to write files" << std::endl;
+    }
+    delivery_log_.Write();
+  }
+
+ private:
+  Face face_;
+  Scheduler scheduler_;
+  Device device_;
+  ClusterHead head_;
+  uint64_t cluster_;
+  NodeID nid_;
+  DeliveryLog delivery_log_;
+};
+
+}  // namespace sync_for_sleep
+}  // namespace vsync
+}  // namespace ndn
@@ -1,9 +1,10 @@
 #include "ns3/ndnSIM-module.h"
+#include "ns3/boolean.h"
 #include "ns3/integer.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 
-#include "sync-sleep-node.hpp"
+#include "cluster-head-node.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -26,7 +27,35 @@ public:
       .AddAttribute("Prefix", "Prefix for sync node", StringValue("/"),
                     MakeNameAccessor(&SyncForSleepApp::prefix_), MakeNameChecker())
       .AddAttribute("GroupSize", "Size of sync node's group", UintegerValue(0),
-                    MakeUintegerAccessor(&SyncForSleepApp::group_size_), MakeUintegerChecker<uint64_t>());
+                    MakeUintegerAccessor(&SyncForSleepApp::group_size_), MakeUintegerChecker<uint64_t>())
+      .AddAttribute("LogDirectory", "Directory of the persistent data logs, empty to disable", StringValue(""),
+                    MakeStringAccessor(&SyncForSleepApp::log_dir_), MakeStringChecker())
+      .AddAttribute("FetchOrder", "Order of the missing data: 0 producer, 1 newest first, 2 random, 3 rarest first",
+                    UintegerValue(0),
+                    MakeUintegerAccessor(&SyncForSleepApp::fetch_order_), MakeUintegerChecker<uint32_t>(0, 3))
+      .AddAttribute("Push", "Push fresh publications to the awake neighbours", BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::push_), MakeBooleanChecker())
+      .AddAttribute("DataRateLower", "Minimum interval between two publications (ms)", UintegerValue(1000),
+                    MakeUintegerAccessor(&SyncForSleepApp::data_rate_lower_), MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("DataRateUpper", "Maximum interval between two publications (ms)", UintegerValue(8000),
+                    MakeUintegerAccessor(&SyncForSleepApp::data_rate_upper_), MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("Repair", "Recover the missing data of a sync with network-coded repair", BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::repair_), MakeBooleanChecker())
+      .AddAttribute("Reconcile", "Reconcile version vectors with IBLTs instead of sending them", BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::reconcile_), MakeBooleanChecker())
+      .AddAttribute("ClusterNum", "Number of clusters if the node heads one, GroupID being the whole group; 0 if not",
+                    UintegerValue(0),
+                    MakeUintegerAccessor(&SyncForSleepApp::cluster_num_), MakeUintegerChecker<uint64_t>())
+      .AddAttribute("Cluster", "Cluster the node heads", UintegerValue(0),
+                    MakeUintegerAccessor(&SyncForSleepApp::cluster_), MakeUintegerChecker<uint64_t>())
+      .AddAttribute("LogDelivery", "Log when every object gets to the node", BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::log_delivery_), MakeBooleanChecker())
+      .AddAttribute("AdaptiveTimers", "Size the deferral window of the responders from the contention",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::adaptive_timers_), MakeBooleanChecker())
+      .AddAttribute("AdaptiveSyncDuration", "Size the awake window of the sync-requester from its responders",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&SyncForSleepApp::adaptive_sync_duration_), MakeBooleanChecker());
       
 
     return tid;
@@ -38,7 +67,18 @@ protected:
   StartApplication()
   {
     std::cout << "calling StartApplication" << std::endl;
-    m_instance.reset(new vsync::sync_for_sleep::SimpleNode(gid_, nid_, prefix_, group_size_));
+    if (cluster_num_ > 0) {
+      m_head.reset(new vsync::sync_for_sleep::ClusterHeadNode(gid_, cluster_, cluster_num_, nid_, prefix_, group_size_,
+                                                              push_, data_rate_lower_, data_rate_upper_,
+                                                              log_delivery_));
+      m_head->Start();
+      return;
+    }
+    m_instance.reset(new vsync::sync_for_sleep::SimpleNode(gid_, nid_, prefix_, group_size_, log_dir_,
+                                                           static_cast<vsync::FetchOrder>(fetch_order_), push_,
+                                                           data_rate_lower_, data_rate_upper_, repair_,
+                                                           reconcile_, log_delivery_, adaptive_timers_,
+                                                           adaptive_sync_duration_));
     m_instance->Start();
   }
 
@@ -46,16 +86,34 @@ protected:
   StopApplication()
   {
     std::cout << "calling StopApplication" << std::endl;
+    if (m_head) {
+      m_head->Stop();
+      m_head.reset();
+      return;
+    }
     m_instance->Stop();
     m_instance.reset();
   }
 
 private:
   std::unique_ptr<vsync::sync_for_sleep::SimpleNode> m_instance;
+  std::unique_ptr<vsync::sync_for_sleep::ClusterHeadNode> m_head;
   vsync::GroupID gid_;
   vsync::NodeID nid_;
   Name prefix_;
   uint64_t group_size_;
+  std::string log_dir_;
+  uint32_t fetch_order_;
+  bool push_;
+  uint32_t data_rate_lower_;
+  uint32_t data_rate_upper_;
+  bool repair_;
+  bool reconcile_;
+  uint64_t cluster_num_;
+  uint64_t cluster_;
+  bool log_delivery_;
+  bool adaptive_timers_;
+  bool adaptive_sync_duration_;
 };
 
 } // namespace ndn
@@ -14,9 +14,57 @@ namespace vsync {
 namespace sync_for_sleep {
 
 static const std::string snapshotFileName = "snapshot.txt";
+static const std::string memoryFileName = "memory.txt";
+static const std::string fetchFileName = "fetch.txt";
+static const std::string deliveryFileName = "delivery.txt";
+
+// fetching: "nid,out_interests,timeouts,window_peak,pushed,push_received,
+// data_sent,data_received,coded_sent,repaired,sync_bytes,iblt_failed,
+// iblt_fallback,sync_delay,sync_extended,sync_cut_short,timer_arms,
+// scheduler_events"
+inline void WriteFetchStats(std::ostream& out, NodeID nid, Node& node) {
+  out << nid << "," << node.GetOutInterestNum() << "," << node.GetFetchTimeoutNum() << ","
+      << node.GetFetchWindowPeak() << "," << node.GetPushSentNum() << "," << node.GetPushRecvNum() << ","
+      << node.GetDataSentNum() << "," << node.GetDataRecvNum() << "," << node.GetRepairSentNum() << ","
+      << node.GetRepairRecoveredNum() << "," << node.GetSyncBytesSent() << ","
+      << node.GetIBLTFailNum() << "," << node.GetIBLTFallbackNum() << "," << node.GetSyncDelay() << ","
+      << node.GetSyncExtendedNum() << "," << node.GetSyncCutShortNum() << ","
+      << node.GetTimerArmNum() << "," << node.GetSchedulerEventNum() << "\n";
+}
+
+/**
+ * @brief When every object got to a node: "name,time_ms,P" for the objects
+ *        the node published and "name,time_ms,R" for the ones it received,
+ *        with relayed objects under their original name.
+ */
+class DeliveryLog {
+ public:
+  void Record(NodeID own_nid, NodeID nid, const Data& data) {
+    auto original = UnwrapRelayedData(data);
+    bool own = original == nullptr && nid == own_nid;
+    const Name& n = original ? original->getName() : data.getName();
+    lines_.push_back(n.toUri() + "," + to_string(time::toUnixTimestamp(time::system_clock::now()).count()) +
+                     (own ? ",P" : ",R"));
+  }
+
+  void Write() const {
+    if (lines_.empty()) return;
+    std::ofstream out;
+    out.open(deliveryFileName, std::ofstream::out | std::ofstream::app);
+    for (const auto& line: lines_) out << line << "\n";
+  }
+
+ private:
+  std::vector<std::string> lines_;
+};
+
 class SimpleNode {
  public:
-  SimpleNode(const GroupID& gid, const NodeID& nid, const Name& prefix, const uint64_t group_size)
+  SimpleNode(const GroupID& gid, const NodeID& nid, const Name& prefix, const uint64_t group_size,
+             const std::string& log_dir = "", FetchOrder fetch_order = kProducerOrder, bool push = false,
+             int data_rate_lower = 1000, int data_rate_upper = 8000, bool repair = false,
+             bool reconcile = false, bool log_delivery = false, bool adaptive_timers = false,
+             bool adaptive_sync_duration = false)
       : scheduler_(face_.getIoService()),
         nid_(nid),
         gid_(gid),
@@ -25,6 +73,20 @@ class SimpleNode {
         rengine_(rdevice_()),
         rdist_(1000, 35000)
         {
+          // one log directory per node, so that the nodes can be restarted independently
+          if (!log_dir.empty()) node_.EnablePersistence(log_dir + "/node-" + to_string(nid));
+          node_.SetFetchOrder(fetch_order);
+          node_.SetPush(push);
+          node_.SetPublishRate(data_rate_lower, data_rate_upper);
+          node_.SetRepair(repair);
+          node_.SetReconciliation(reconcile);
+          node_.SetAdaptiveTimers(adaptive_timers);
+          node_.SetAdaptiveSyncDuration(adaptive_sync_duration);
+          if (log_delivery) {
+            node_.SetNewDataCallback([this] (NodeID nid, uint64_t, const Data& data) {
+              delivery_log_.Record(nid_, nid, data);
+            });
+          }
         }
 
   void Start() {
@@ -43,7 +105,7 @@ class SimpleNode {
     if (out.is_open()) {
       std::vector<uint64_t> data_snapshots = node_.GetDataSnapshots();
       std::vector<VersionVector> vv_snapshots = node_.GetVVSnapshots();
-      std::vector<std::vector<ReceiveWindow>> rw_snapshots = node_.GetRWSnapshots();
+      std::vector<ReceiveWindows> rw_snapshots = node_.GetRWSnapshots();
       std::vector<std::pair<double, int>> receive_first_syncACK_delay = node_.ReceiveFirstSyncACKDelay();
       std::vector<std::pair<double, int>> receive_last_syncACK_delay = node_.ReceiveLastSyncACKDelay();
       auto first_syncACK_str = ToString(receive_first_syncACK_delay);
@@ -79,10 +141,36 @@ class SimpleNode {
       for (auto rw: rw_snapshots) {
         out << ToString(rw) << "\n";
       }
+      // the deferral window: "dt:loss_rate:responders" at every snapshot
+      out << ToString(node_.GetTimerSnapshots()) << "\n";
     }
     else {
       std::cout << "Fail to write files" << std::endl; 
     }
+
+    // data store usage: "nid,objects,bytes,peak_bytes,evicted,pending_peak,pending_peak_ranges"
+    // then the byte snapshots
+    std::ofstream mem_out;
+    mem_out.open(memoryFileName, std::ofstream::out | std::ofstream::app);
+    if (mem_out.is_open()) {
+      mem_out << nid_ << "," << node_.GetStoreSize() << "," << node_.GetStoreBytes() << ","
+              << node_.GetStorePeakBytes() << "," << node_.GetEvictedNum() << ","
+              << node_.GetPendingPeak() << "," << node_.GetPendingPeakRanges() << "\n";
+      mem_out << ToString(node_.GetStoreSnapshots()) << "\n";
+    }
+    else {
+      std::cout << "Fail to write files" << std::endl; 
+    }
+
+    std::ofstream fetch_out;
+    fetch_out.open(fetchFileName, std::ofstream::out | std::ofstream::app);
+    if (fetch_out.is_open()) {
+      WriteFetchStats(fetch_out, nid_, node_);
+    }
+    else {
+      std::cout << "Fail to write files" << std::endl; 
+    }
+    delivery_log_.Write();
   }
 
   /*
@@ -115,11 +203,19 @@ class SimpleNode {
     return res;
   }
 
-  std::string ToString(std::vector<ReceiveWindow> rw) {
+  std::string ToString(const std::vector<Node::TimerSnapshot>& list) {
+    std::string res = "";
+    for (const auto& timer: list) {
+      if (!res.empty()) res += ",";
+      res += to_string(timer.dt) + ":" + to_string(timer.loss_rate) + ":" + to_string(timer.responders);
+    }
+    return res;
+  }
+
+  std::string ToString(const ReceiveWindows& rw) {
     std::string res = "";
     for (int i = 0; i < rw.size(); ++i) {
-      ReceiveWindow recv_window = rw[i];
-      ReceiveWindow::SeqNumIntervalSet win = recv_window.getWin();
+      auto win = rw[i].getWin();
       if (win.iterative_size() == 0) continue;
       auto it = win.begin();
       while (it != win.end()) {
@@ -136,6 +232,7 @@ private:
   NodeID nid_;
   GroupID gid_;
   Node node_;
+  DeliveryLog delivery_log_;
 
   std::random_device rdevice_;
   std::mt19937 rengine_;
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Pull traffic with and without the push of fresh publications, at several
+# publication intervals (ms). Every run appends one line per setting to
+# result2/push-traffic.txt:
+#   lower upper push out_interests pushed push_received
+for rate in "500 1000" "1000 8000" "4000 16000"
+do
+  set -- $rate
+  for push in 0 1
+  do
+    echo "start simulation: interval $1-$2 ms, push=$push"
+    rm -f snapshot.txt memory.txt fetch.txt
+    ./waf --run "sync-for-sleep --push=$push --dataRateLower=$1 --dataRateUpper=$2" >/dev/null
+    awk -F, -v l=$1 -v u=$2 -v p=$push '{ out += $2; pushed += $5; recv += $6 }
+      END { print l, u, p, out, pushed, recv }' fetch.txt >> result2/push-traffic.txt
+  done
+done
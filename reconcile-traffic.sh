@@ -0,0 +1,18 @@
+#!/bin/bash
+# Airtime of the sync state and sync delay with the version vectors sent in
+# the sync interests and with IBLT reconciliation, for several group sizes.
+# Each member publishes 20 times less often than by default, so that 200
+# members publish as much as 10 do.
+# Every run appends one line per setting to result2/reconcile-traffic.txt:
+#   nodes reconcile sync_bytes iblt_failed iblt_fallback sync_delay_ms_per_node
+for nodes in 50 200 500
+do
+  for reconcile in 0 1
+  do
+    echo "start simulation: $nodes nodes, reconcile=$reconcile"
+    rm -f snapshot.txt memory.txt fetch.txt
+    ./waf --run "sync-for-sleep --nodes=$nodes --rounds=3 --reconcile=$reconcile --dataRateLower=20000 --dataRateUpper=160000" >/dev/null
+    awk -F, -v n=$nodes -v r=$reconcile '{ bytes += $11; failed += $12; fallback += $13; delay += $14 }
+      END { print n, r, bytes, failed, fallback, (NR ? delay / NR : 0) }' fetch.txt >> result2/reconcile-traffic.txt
+  done
+done
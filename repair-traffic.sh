@@ -0,0 +1,18 @@
+#!/bin/bash
+# Transmissions per recovered object with and without network-coded repair,
+# at several publication intervals (ms). Push is off so that every object is
+# recovered by a sync. Every run appends one line per setting to
+# result2/repair-traffic.txt:
+#   lower upper repair data_sent data_received coded_sent repaired sent_per_recovered
+for rate in "500 1000" "1000 8000" "4000 16000"
+do
+  set -- $rate
+  for repair in 0 1
+  do
+    echo "start simulation: interval $1-$2 ms, repair=$repair"
+    rm -f snapshot.txt memory.txt fetch.txt
+    ./waf --run "sync-for-sleep --push=0 --repair=$repair --dataRateLower=$1 --dataRateUpper=$2" >/dev/null
+    awk -F, -v l=$1 -v u=$2 -v r=$repair '{ sent += $7; recv += $8; coded += $9; repaired += $10 }
+      END { print l, u, r, sent, recv, coded, repaired, (recv ? sent / recv : 0) }' fetch.txt >> result2/repair-traffic.txt
+  done
+done
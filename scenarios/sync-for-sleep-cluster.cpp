@@ -0,0 +1,200 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/unsolicited-data-policy.hpp"
+
+#include "broadcast_strategy.hpp"
+#include "cluster.hpp"
+
+#include <cmath>
+#include <map>
+
+using namespace std;
+using namespace ns3;
+
+using ns3::ndn::StackHelper;
+using ns3::ndn::AppHelper;
+using ns3::ndn::StrategyChoiceHelper;
+using ns3::ndn::L3RateTracer;
+using ns3::ndn::FibHelper;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SyncForSleepCluster");
+
+//
+// sync-for-sleep with a group larger than one radio neighbourhood, split
+// into clusters of clusterSize members in a grid of 50 m cells. Member 0 of
+// every cluster heads it, at the centre of the cell, and syncs with the other
+// heads in the backbone group. With --flat, the same nodes at the same
+// positions form one group instead; see cluster-traffic.sh for the
+// convergence time and the traffic of both modes.
+//
+
+int
+main (int argc, char *argv[])
+{
+  // disable fragmentation
+  Config::SetDefault ("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue ("2200"));
+  Config::SetDefault ("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue ("2200"));
+  Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue ("OfdmRate24Mbps"));
+
+  uint32_t nodeNum = 200;
+  uint32_t clusterSize = 10;
+  bool flat = false;
+  uint32_t rounds = 3;
+  bool push = false;
+  uint32_t dataRateLower = 20000;
+  uint32_t dataRateUpper = 160000;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of members of the group", nodeNum);
+  cmd.AddValue ("clusterSize", "Number of members of a cluster", clusterSize);
+  cmd.AddValue ("flat", "Sync all the members in one group", flat);
+  cmd.AddValue ("rounds", "Number of flat sync rounds to simulate", rounds);
+  cmd.AddValue ("push", "Push fresh publications to the awake neighbours", push);
+  cmd.AddValue ("dataRateLower", "Minimum interval between two publications (ms)", dataRateLower);
+  cmd.AddValue ("dataRateUpper", "Maximum interval between two publications (ms)", dataRateUpper);
+  cmd.Parse (argc,argv);
+
+  const std::string gid = "group0";
+  const double cellSize = 50.0;
+  uint32_t clusterNum = (nodeNum + clusterSize - 1) / clusterSize;
+  uint32_t gridSide = static_cast<uint32_t>(std::ceil(std::sqrt(clusterNum)));
+
+  // a flat round takes members x kSyncDelay (4 s); both modes run as long
+  double stopTime = 2.0 + 4.0 * nodeNum * rounds;
+
+  //////////////////////
+  //////////////////////
+  //////////////////////
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate24Mbps"));
+
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss ("ns3::ThreeLogDistancePropagationLossModel");
+  wifiChannel.AddPropagationLoss ("ns3::NakagamiPropagationLossModel");
+
+  YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default ();
+  wifiPhyHelper.SetChannel (wifiChannel.Create ());
+  wifiPhyHelper.Set("TxPowerStart", DoubleValue(15));
+  wifiPhyHelper.Set("TxPowerEnd", DoubleValue(15));
+
+  NqosWifiMacHelper wifiMacHelper = NqosWifiMacHelper::Default ();
+  wifiMacHelper.SetType("ns3::AdhocWifiMac");
+
+  // the cluster groups are named as by ndn::vsync::MakeClusterGroupID.
+  // node idx is member idx % clusterSize of cluster idx / clusterSize, in
+  // cell (cluster % gridSide, cluster / gridSide)
+  Ptr<UniformRandomVariable> randomizer = CreateObject<UniformRandomVariable> ();
+  randomizer->SetAttribute ("Min", DoubleValue (0));
+  randomizer->SetAttribute ("Max", DoubleValue (cellSize));
+
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t idx = 0; idx < nodeNum; idx++) {
+    uint32_t cluster = idx / clusterSize;
+    double x = (cluster % gridSide) * cellSize;
+    double y = (cluster / gridSide) * cellSize;
+    if (idx % clusterSize == 0)
+      positions->Add (Vector (x + cellSize / 2, y + cellSize / 2, 0));
+    else
+      positions->Add (Vector (x + randomizer->GetValue (), y + randomizer->GetValue (), 0));
+  }
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+
+  NodeContainer nodes;
+  nodes.Create (nodeNum);
+
+  ////////////////
+  // 1. Install Wifi
+  NetDeviceContainer wifiNetDevices = wifi.Install (wifiPhyHelper, wifiMacHelper, nodes);
+
+  // 2. Install Mobility model
+  mobility.Install (nodes);
+
+  // 3. Install NDN stack
+  NS_LOG_INFO ("Installing NDN stack");
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  // 4. Set Forwarding Strategy
+  StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/multicast");
+
+  // pushed publications reach the nodes without a pending push interest as
+  // unsolicited data; let their content stores keep it
+  if (push) {
+    for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+      (*i)->GetObject<ndn::L3Protocol>()->getForwarder()->setUnsolicitedDataPolicy(
+        std::unique_ptr<nfd::fw::UnsolicitedDataPolicy>(new nfd::fw::AdmitNetworkUnsolicitedDataPolicy()));
+    }
+  }
+
+  // install SyncApp
+  uint64_t idx = 0;
+  for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+    Ptr<Node> object = *i;
+    Ptr<MobilityModel> position = object->GetObject<MobilityModel>();
+    Vector pos = position->GetPosition();
+    std::cout << "node " << idx << " position: " << pos.x << " " << pos.y << std::endl;
+
+    uint64_t cluster = idx / clusterSize;
+    uint64_t member = idx % clusterSize;
+    uint64_t size = std::min<uint64_t>(clusterSize, nodeNum - cluster * clusterSize);
+
+    AppHelper syncForSleepAppHelper("SyncForSleepApp");
+    syncForSleepAppHelper.SetAttribute("Prefix", StringValue("/"));
+    syncForSleepAppHelper.SetAttribute("Push", BooleanValue(push));
+    syncForSleepAppHelper.SetAttribute("DataRateLower", UintegerValue(dataRateLower));
+    syncForSleepAppHelper.SetAttribute("DataRateUpper", UintegerValue(dataRateUpper));
+    syncForSleepAppHelper.SetAttribute("LogDelivery", BooleanValue(true));
+    if (flat) {
+      syncForSleepAppHelper.SetAttribute("GroupID", StringValue(gid));
+      syncForSleepAppHelper.SetAttribute("NodeID", UintegerValue(idx));
+      syncForSleepAppHelper.SetAttribute("GroupSize", UintegerValue(nodeNum));
+    }
+    else if (member == 0) {
+      syncForSleepAppHelper.SetAttribute("GroupID", StringValue(gid));
+      syncForSleepAppHelper.SetAttribute("NodeID", UintegerValue(member));
+      syncForSleepAppHelper.SetAttribute("GroupSize", UintegerValue(size));
+      syncForSleepAppHelper.SetAttribute("Cluster", UintegerValue(cluster));
+      syncForSleepAppHelper.SetAttribute("ClusterNum", UintegerValue(clusterNum));
+    }
+    else {
+      syncForSleepAppHelper.SetAttribute("GroupID", StringValue(::ndn::vsync::MakeClusterGroupID(gid, cluster)));
+      syncForSleepAppHelper.SetAttribute("NodeID", UintegerValue(member));
+      syncForSleepAppHelper.SetAttribute("GroupSize", UintegerValue(size));
+    }
+    auto app = syncForSleepAppHelper.Install(object);
+    app.Start(Seconds(2));
+    app.Stop(Seconds (stopTime + idx * 0.01));
+
+    StackHelper::setNodeID(idx, object);
+    // routes without the group ID, for the clusters and the backbone, and so
+    // that the nodes forward the packets of the groups they are not in
+    for (const char* prefix: {"/ndn/sleepingProbe", "/ndn/sleepingReply", "/ndn/vsync", "/ndn/vsyncData",
+                              "/ndn/vsyncDatalist", "/ndn/vsyncVV", "/ndn/vsyncRepair", "/ndn/sleepingCommand",
+                              "/ndn/syncACK"}) {
+      FibHelper::AddRoute(object, prefix, std::numeric_limits<int32_t>::max());
+    }
+    idx++;
+  }
+
+  ////////////////
+
+  Simulator::Stop (Seconds (stopTime + nodeNum * 0.01 + 50.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -7,8 +7,12 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/ndnSIM-module.h"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/unsolicited-data-policy.hpp"
+
 #include "broadcast_strategy.hpp"
 
+#include <chrono>
+#include <iostream>
 #include <map>
 
 using namespace std;
@@ -44,9 +48,39 @@ main (int argc, char *argv[])
   Config::SetDefault ("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue ("2200"));
   Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue ("OfdmRate24Mbps"));
 
+  // order of the missing data, see vsync::FetchOrder; compare collision_num and
+  // the sync delay in snapshot.txt between runs
+  uint32_t fetchOrder = 0;
+  // push of fresh publications, and the publication interval in ms; see
+  // push-traffic.sh for the pull traffic it removes
+  bool push = false;
+  uint32_t dataRateLower = 1000;
+  uint32_t dataRateUpper = 8000;
+  // network-coded repair of the missing data; see repair-traffic.sh for the
+  // transmissions per recovered object with and without it
+  bool repair = false;
+  // group size and IBLT reconciliation of the version vectors; see
+  // reconcile-traffic.sh for large groups with and without it. With rounds > 0
+  // the run lasts that many sync rounds of members x 4 s instead of 1300 s.
+  uint32_t nodeNum = 10;
+  uint32_t rounds = 0;
+  bool reconcile = false;
+
   CommandLine cmd;
+  cmd.AddValue ("fetchOrder", "0 producer order, 1 newest first, 2 random, 3 rarest first", fetchOrder);
+  cmd.AddValue ("push", "Push fresh publications to the awake neighbours", push);
+  cmd.AddValue ("dataRateLower", "Minimum interval between two publications (ms)", dataRateLower);
+  cmd.AddValue ("dataRateUpper", "Maximum interval between two publications (ms)", dataRateUpper);
+  cmd.AddValue ("repair", "Recover the missing data of a sync with network-coded repair", repair);
+  cmd.AddValue ("nodes", "Number of members of the group", nodeNum);
+  cmd.AddValue ("rounds", "Number of sync rounds to simulate, 0 for 1300 s", rounds);
+  cmd.AddValue ("reconcile", "Reconcile version vectors with IBLTs instead of sending them", reconcile);
   cmd.Parse (argc,argv);
 
+  // a round takes members x kSyncDelay (4 s); the apps stop one after another
+  double stopTime = rounds > 0 ? 2.0 + 4.0 * nodeNum * rounds : 1300.0;
+  double stopStep = rounds > 0 ? 0.01 : 1.0;
+
   //////////////////////
   //////////////////////
   //////////////////////
@@ -88,7 +122,7 @@ main (int argc, char *argv[])
   mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
 
   NodeContainer nodes;
-  nodes.Create (10);
+  nodes.Create (nodeNum);
 
   ////////////////
   // 1. Install Wifi
@@ -109,6 +143,15 @@ main (int argc, char *argv[])
   // StrategyChoiceHelper::Install<nfd::fw::BroadcastStrategy>(nodes, "/");
   StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/multicast");
 
+  // pushed publications reach the nodes without a pending push interest as
+  // unsolicited data; let their content stores keep it
+  if (push) {
+    for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+      (*i)->GetObject<ndn::L3Protocol>()->getForwarder()->setUnsolicitedDataPolicy(
+        std::unique_ptr<nfd::fw::UnsolicitedDataPolicy>(new nfd::fw::AdmitNetworkUnsolicitedDataPolicy()));
+    }
+  }
+
   // initialize the total vector clock
 
   // install SyncApp
@@ -123,16 +166,25 @@ main (int argc, char *argv[])
     syncForSleepAppHelper.SetAttribute("GroupID", StringValue("group0"));
     syncForSleepAppHelper.SetAttribute("NodeID", UintegerValue(idx));
     syncForSleepAppHelper.SetAttribute("Prefix", StringValue("/"));
-    syncForSleepAppHelper.SetAttribute("GroupSize", UintegerValue(10));
+    syncForSleepAppHelper.SetAttribute("GroupSize", UintegerValue(nodeNum));
+    syncForSleepAppHelper.SetAttribute("FetchOrder", UintegerValue(fetchOrder));
+    syncForSleepAppHelper.SetAttribute("Push", BooleanValue(push));
+    syncForSleepAppHelper.SetAttribute("DataRateLower", UintegerValue(dataRateLower));
+    syncForSleepAppHelper.SetAttribute("DataRateUpper", UintegerValue(dataRateUpper));
+    syncForSleepAppHelper.SetAttribute("Repair", BooleanValue(repair));
+    syncForSleepAppHelper.SetAttribute("Reconcile", BooleanValue(reconcile));
     auto app = syncForSleepAppHelper.Install(object);
     app.Start(Seconds(2));
-    app.Stop(Seconds (1300.0 + idx));
+    app.Stop(Seconds (stopTime + idx * stopStep));
 
     StackHelper::setNodeID(idx, object);
     FibHelper::AddRoute(object, "/ndn/sleepingProbe/group0", std::numeric_limits<int32_t>::max());
     FibHelper::AddRoute(object, "/ndn/sleepingReply/group0", std::numeric_limits<int32_t>::max());
     FibHelper::AddRoute(object, "/ndn/vsync/group0", std::numeric_limits<int32_t>::max());
     FibHelper::AddRoute(object, "/ndn/vsyncData/group0", std::numeric_limits<int32_t>::max());
+    FibHelper::AddRoute(object, "/ndn/vsyncDatalist/group0", std::numeric_limits<int32_t>::max());
+    FibHelper::AddRoute(object, "/ndn/vsyncVV/group0", std::numeric_limits<int32_t>::max());
+    FibHelper::AddRoute(object, "/ndn/vsyncRepair/group0", std::numeric_limits<int32_t>::max());
     FibHelper::AddRoute(object, "/ndn/sleepingCommand/group0", std::numeric_limits<int32_t>::max());
     FibHelper::AddRoute(object, "/ndn/syncACK/group0", std::numeric_limits<int32_t>::max());
     idx++;
@@ -140,11 +192,17 @@ main (int argc, char *argv[])
 
   ////////////////
 
-  Simulator::Stop (Seconds (1350.0));
+  Simulator::Stop (Seconds (rounds > 0 ? stopTime + nodeNum * stopStep + 50.0 : 1350.0));
 
   // L3RateTracer::InstallAll("test-rate-trace.txt", Seconds(0.5));
   // L2RateTracer::InstallAll("drop-trace.txt", Seconds(0.5));
+  auto start = std::chrono::steady_clock::now();
   Simulator::Run ();
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  // events/s and wall-clock per simulated second, for timing the timers
+  std::cout << "simulated " << Simulator::Now().GetSeconds() << " s in " << wall << " s: "
+            << Simulator::GetEventCount() / wall << " events/s, "
+            << wall * 1000 / Simulator::Now().GetSeconds() << " ms per simulated s" << std::endl;
   Simulator::Destroy ();
 
   return 0;
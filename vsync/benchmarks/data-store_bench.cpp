@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares the Name-keyed hash map that Node used as its data store with
+// DataStore, for 10k, 100k and 1M stored objects spread over 10 producers.
+//
+// Usage: data-store-bench
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+#include "data-store.hpp"
+#include "ndn-common.hpp"
+#include "vsync-helper.hpp"
+
+using namespace ndn;
+using namespace ndn::vsync;
+
+static const size_t kProducers = 10;
+
+static double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+  std::cout << std::setw(10) << "objects" << std::setw(14) << "store" << std::setw(14) << "insert ns"
+            << std::setw(14) << "lookup ns" << "\n";
+
+  // the store counts wire-encoded bytes, so the objects are signed, outside
+  // the timed loops
+  KeyChain key_chain;
+  for (size_t total : {10000, 100000, 1000000}) {
+    size_t per_producer = total / kProducers;
+    // lookups start from incoming interest names, as in Node::OnDataInterest
+    std::vector<Name> names;
+    std::vector<std::shared_ptr<const Data>> objects;
+    names.reserve(total);
+    objects.reserve(total);
+    for (uint64_t seq = 1; seq <= per_producer; ++seq) {
+      for (NodeID nid = 0; nid < kProducers; ++nid) {
+        names.push_back(MakeDataName("group0", nid, seq));
+        auto data = std::make_shared<Data>(names.back());
+        key_chain.sign(*data, signingWithSha256());
+        objects.push_back(data);
+      }
+    }
+
+    {
+      std::unordered_map<Name, std::shared_ptr<const Data>> map;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < total; ++i) map[names[i]] = objects[i];
+      double insert = Seconds(start);
+      size_t hits = 0;
+      start = std::chrono::steady_clock::now();
+      for (const auto& n : names) hits += map.find(n) != map.end();
+      double lookup = Seconds(start);
+      std::cout << std::setw(10) << total << std::setw(14) << "name map" << std::fixed << std::setprecision(1)
+                << std::setw(14) << insert * 1e9 / total << std::setw(14) << lookup * 1e9 / total
+                << (hits == total ? "" : "  (missed lookups!)") << "\n";
+    }
+
+    {
+      DataStore store(kProducers);
+      NodeID nid;
+      uint64_t seq;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < total; ++i) {
+        ParseDataName(names[i], nid, seq);
+        store.Insert(nid, seq, objects[i]);
+      }
+      double insert = Seconds(start);
+      size_t hits = 0;
+      start = std::chrono::steady_clock::now();
+      for (const auto& n : names) hits += ParseDataName(n, nid, seq) && store.Has(nid, seq);
+      double lookup = Seconds(start);
+      std::cout << std::setw(10) << total << std::setw(14) << "DataStore" << std::fixed << std::setprecision(1)
+                << std::setw(14) << insert * 1e9 / total << std::setw(14) << lookup * 1e9 / total
+                << (hits == total ? "" : "  (missed lookups!)") << "\n";
+    }
+  }
+  return 0;
+}
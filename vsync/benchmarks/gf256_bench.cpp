@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares the scalar and AVX2 GF(2^8) kernels, and times the decoding of
+// one repair generation.
+//
+// Usage: gf256-bench [iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gf256.hpp"
+#include "network-coding.hpp"
+
+using namespace ndn::vsync;
+
+template <typename F>
+static double NsPerCall(F f, size_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+  std::cout << "AVX2 " << (gf256::HasAVX2() ? "available" : "not available") << "\n";
+  std::cout << std::setw(6) << "size" << std::setw(18) << "muladd scalar" << std::setw(18) << "muladd avx2"
+            << "   (MB/s)\n";
+
+  std::mt19937 rengine(1);
+  std::uniform_int_distribution<int> rdist(0, 255);
+  for (size_t n : {64, 256, 1400, 4096}) {
+    std::vector<uint8_t> src(n), dst(n);
+    for (auto& b: src) b = static_cast<uint8_t>(rdist(rengine));
+    uint8_t c = 0x57;
+
+    double scalar = NsPerCall([&] { gf256::MulAddScalar(dst.data(), src.data(), c, n); }, iterations);
+    double avx2 = NsPerCall([&] { gf256::MulAddAVX2(dst.data(), src.data(), c, n); }, iterations);
+
+    std::cout << std::setw(6) << n << std::fixed << std::setprecision(1)
+              << std::setw(18) << n * 1e3 / scalar << std::setw(18) << n * 1e3 / avx2 << "\n";
+  }
+
+  // one generation of 1400-byte objects, half of them already known
+  std::cout << std::setw(6) << "items" << std::setw(18) << "encode (us)" << std::setw(18) << "decode (us)" << "\n";
+  for (size_t k : {4, 16, 32}) {
+    RepairEncoder encoder;
+    std::vector<std::string> objects(k, std::string(1400, 0));
+    for (size_t i = 0; i < k; ++i) {
+      for (auto& b: objects[i]) b = static_cast<char>(rdist(rengine));
+      encoder.Add(0, i + 1, reinterpret_cast<const uint8_t*>(objects[i].data()), objects[i].size());
+    }
+    std::vector<std::string> packets;
+    size_t rounds = std::max<size_t>(1, iterations / 1000);
+    double encode = NsPerCall([&] { packets.push_back(encoder.Encode(rengine)); }, k * rounds) * k;
+    double decode = NsPerCall([&] {
+      RepairDecoder decoder([&] (NodeID, uint64_t seq, std::string& wire) {
+        if (seq % 2) return false;
+        wire = objects[seq - 1];
+        return true;
+      });
+      for (size_t i = 0; !decoder.Complete() && i < packets.size(); ++i) {
+        decoder.Add(reinterpret_cast<const uint8_t*>(packets[i].data()), packets[i].size());
+      }
+    }, rounds);
+
+    std::cout << std::setw(6) << k << std::fixed << std::setprecision(1)
+              << std::setw(18) << encode / 1e3 << std::setw(18) << decode / 1e3 << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares the per-member state of Node with the inline capacity of
+// VersionVector (kInlineGroupSize), with an inline capacity matching the
+// group size (what one Node instantiation per group size would use), and
+// with a plain std::vector, for groups of 8 to 128 members.
+//
+// Per call: a snapshot (copy of the vector), a decode into the scratch
+// vector (clear and refill) and a merge into the local vector, the work a
+// node does on every sync interest and snapshot.
+//
+// Usage: member-vector-bench [iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "vsync-common.hpp"
+
+using namespace ndn::vsync;
+
+template <typename F>
+static double NsPerCall(F f, size_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+template <typename Vector>
+static double Sync(const std::vector<uint64_t>& wire, size_t iterations) {
+  size_t n = wire.size();
+  Vector local(n), scratch;
+  volatile uint64_t sink = 0;
+  double ns = NsPerCall([&] {
+    Vector snapshot(local);
+    sink = snapshot[n - 1];
+    scratch.clear();
+    for (size_t i = 0; i < n; ++i) scratch.push_back(wire[i]);
+    for (size_t i = 0; i < n; ++i) local[i] = std::max(local[i], scratch[i]);
+    local[sink % n]++;
+  }, iterations);
+  (void)sink;
+  return ns;
+}
+
+template <size_t N>
+static double Matched(const std::vector<uint64_t>& wire, size_t iterations) {
+  return Sync<MemberVector<uint64_t, N>>(wire, iterations);
+}
+
+int main(int argc, char* argv[]) {
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+  std::cout << std::setw(6) << "size" << std::setw(16) << "std::vector" << std::setw(16) << "inline 16"
+            << std::setw(16) << "inline = size" << "   (ns/call)\n";
+
+  std::mt19937 rengine(1);
+  std::uniform_int_distribution<uint64_t> rdist(0, 100000);
+  for (size_t n : {8, 16, 32, 64, 128}) {
+    std::vector<uint64_t> wire(n);
+    for (auto& seq: wire) seq = rdist(rengine);
+
+    double heap = Sync<std::vector<uint64_t>>(wire, iterations);
+    double fixed = Sync<VersionVector>(wire, iterations);
+    double matched = n <= 8 ? Matched<8>(wire, iterations) : n <= 16 ? Matched<16>(wire, iterations)
+                   : n <= 32 ? Matched<32>(wire, iterations) : n <= 64 ? Matched<64>(wire, iterations)
+                   : Matched<128>(wire, iterations);
+
+    std::cout << std::setw(6) << n << std::fixed << std::setprecision(2)
+              << std::setw(16) << heap << std::setw(16) << fixed << std::setw(16) << matched << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares the interval-set ReceiveWindow with BitmapReceiveWindow: insert
+// and lookup throughput for in-order and mostly-in-order arrivals, and the
+// heap memory held per window.
+//
+// Usage: recv-window-bench [sequence numbers per window]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "recv-window.hpp"
+
+using namespace ndn::vsync;
+
+// live heap bytes, to measure the memory held by the windows
+static size_t g_live_bytes = 0;
+
+void* operator new(size_t size) {
+  void* p = std::malloc(size + sizeof(size_t));
+  if (p == nullptr) throw std::bad_alloc();
+  *static_cast<size_t*>(p) = size;
+  g_live_bytes += size;
+  return static_cast<size_t*>(p) + 1;
+}
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr) return;
+  size_t* base = static_cast<size_t*>(p) - 1;
+  g_live_bytes -= *base;
+  std::free(base);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  operator delete(p);
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// arrival order: 1..n, with a fraction of the sequence numbers delayed by a few places
+static std::vector<uint64_t> Arrivals(uint64_t n, double reorder) {
+  std::vector<uint64_t> seqs(n);
+  for (uint64_t i = 0; i < n; ++i) seqs[i] = i + 1;
+  std::mt19937 rengine(1);
+  std::uniform_real_distribution<> coin(0, 1);
+  std::uniform_int_distribution<uint64_t> shift(1, 8);
+  for (uint64_t i = 0; i + 8 < n; ++i) {
+    if (coin(rengine) < reorder) std::swap(seqs[i], seqs[i + shift(rengine)]);
+  }
+  return seqs;
+}
+
+template <typename W>
+static void Run(const std::string& name, const std::vector<uint64_t>& seqs, double reorder) {
+  const size_t kWindows = 100;
+  std::vector<W> windows(kWindows);
+  auto start = std::chrono::steady_clock::now();
+  for (auto& w : windows) {
+    for (uint64_t seq : seqs) w.Insert(seq);
+  }
+  double insert_ns = Seconds(start) * 1e9 / (kWindows * seqs.size());
+
+  // held memory, with half of the last arrivals still missing
+  std::vector<W> partial(kWindows);
+  size_t partial_before = g_live_bytes;
+  for (auto& w : partial) {
+    for (size_t i = 0; i < seqs.size(); ++i) {
+      if (i < seqs.size() - 64 || i % 2 == 0) w.Insert(seqs[i]);
+    }
+  }
+  double bytes_per_window = double(g_live_bytes - partial_before) / kWindows + sizeof(W);
+
+  volatile size_t hits = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto& w : windows) {
+    for (uint64_t seq = 1; seq <= seqs.size(); seq += 7) hits += w.HasData(seq);
+  }
+  double lookup_ns = Seconds(start) * 1e9 / (kWindows * (seqs.size() / 7 + 1));
+
+  std::cout << std::fixed << std::setprecision(2) << std::setw(8) << reorder << std::setw(12) << name
+            << std::setprecision(1) << std::setw(14) << insert_ns << std::setw(14) << lookup_ns
+            << std::setw(16) << bytes_per_window << "\n";
+}
+
+int main(int argc, char* argv[]) {
+  uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+  std::cout << std::setw(8) << "reorder" << std::setw(12) << "window" << std::setw(14) << "insert ns"
+            << std::setw(14) << "lookup ns" << std::setw(16) << "bytes/window" << "\n";
+  for (double reorder : {0.0, 0.01, 0.1}) {
+    auto seqs = Arrivals(n, reorder);
+    Run<ReceiveWindow>("interval", seqs, reorder);
+    Run<BitmapReceiveWindow>("bitmap", seqs, reorder);
+  }
+  return 0;
+}
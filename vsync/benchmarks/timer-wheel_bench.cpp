@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares Node's timers on one ordered event set shared by every simulated
+// node, as with the Scheduler of ndnSIM, with the same timers on a
+// TimerWheel per node, for 100, 500 and 1000 nodes in groups of 10 over
+// 120 simulated seconds.
+//
+// Each node runs the timers of Node: CheckState every 4 s, a publication
+// every 1-8 s, a snapshot every 8 s, and while it is the sync-requester the
+// sync interest timeout every 23 ms for 150 ms. Every interest sent in a
+// group, and its data, make the awake members cancel DT and WT and re-arm
+// WT, as OnIncomingInterest does; the sender re-arms DT. Both variants see
+// the same packets, which are themselves events of the shared set.
+//
+// Reported: operations on the shared set (inserts and erases), events popped
+// from it, events handled (packets and timer callbacks, the same work in both
+// variants) per wall-clock second, and wall-clock time per simulated second.
+//
+// Usage: timer-wheel-bench
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "timer-wheel.hpp"
+
+using namespace ndn;
+using namespace ndn::vsync;
+
+static const uint64_t kSimulated = 120000;  // ms
+static const uint64_t kGroupSize = 10;
+static const uint64_t kActive = 4;  // the sync-requester and its responders
+static const uint64_t kSyncDelay = 4000;
+
+// the event set of the simulator: events in time order, with a handle to
+// erase them, and the callback held by the event as in the Scheduler
+class Simulation {
+ public:
+  struct Event {
+    uint64_t time;
+    uint64_t id;
+    std::function<void()> fn;
+    bool operator<(const Event& other) const {
+      return time < other.time || (time == other.time && id < other.id);
+    }
+  };
+  using Handle = std::multiset<Event>::iterator;
+
+  Handle Insert(uint64_t time, std::function<void()> fn) {
+    ops++;
+    return queue_.insert(Event{time, next_id_++, std::move(fn)});
+  }
+
+  void Erase(Handle h) {
+    ops++;
+    queue_.erase(h);
+  }
+
+  void Run(uint64_t until) {
+    while (!queue_.empty() && queue_.begin()->time <= until) {
+      auto first = queue_.begin();
+      now = first->time;
+      auto fn = std::move(first->fn);
+      queue_.erase(first);
+      events++;
+      fn();
+    }
+  }
+
+  uint64_t now = 0;
+  uint64_t ops = 0;
+  uint64_t events = 0;
+  uint64_t packets = 0;
+
+ private:
+  std::multiset<Event> queue_;
+  uint64_t next_id_ = 0;
+};
+
+// a timer as an event of the shared set
+class SetTimer {
+ public:
+  SetTimer(Simulation& sim, std::function<void()> fn) : sim_(sim), fn_(std::move(fn)) {}
+
+  void Arm(uint64_t delay) {
+    Cancel();
+    armed_ = true;
+    handle_ = sim_.Insert(sim_.now + delay, [this] {
+      armed_ = false;
+      fn_();
+    });
+  }
+
+  void Cancel() {
+    if (!armed_) return;
+    sim_.Erase(handle_);
+    armed_ = false;
+  }
+
+ private:
+  Simulation& sim_;
+  std::function<void()> fn_;
+  Simulation::Handle handle_;
+  bool armed_ = false;
+};
+
+// a wheel whose one wake-up is an event of the shared set
+class SimulatedWheel : public TimerWheel {
+ public:
+  explicit SimulatedWheel(Simulation& sim) : sim_(sim) {}
+
+ protected:
+  uint64_t Now() const override { return sim_.now; }
+
+  void OnWake(uint64_t tick) override {
+    if (armed_) sim_.Erase(handle_);
+    armed_ = tick != kNever;
+    if (!armed_) return;
+    handle_ = sim_.Insert(tick, [this] {
+      armed_ = false;
+      Advance(sim_.now);
+    });
+  }
+
+ private:
+  Simulation& sim_;
+  Simulation::Handle handle_;
+  bool armed_ = false;
+};
+
+class WheelTimer {
+ public:
+  WheelTimer(SimulatedWheel& wheel, std::function<void()> fn) : timer_(wheel, std::move(fn)) {}
+  void Arm(uint64_t delay) { timer_.Arm(time::milliseconds(delay)); }
+  void Cancel() { timer_.Cancel(); }
+
+ private:
+  TimerWheel::Timer timer_;
+};
+
+template <class Timer, class Context>
+class BenchNode {
+ public:
+  BenchNode(Context& context, uint64_t nid, std::mt19937& rengine)
+      : nid_(nid),
+        rengine_(rengine),
+        state_(context, [this] { CheckState(); }),
+        publish_(context, [this] { Publish(); }),
+        snapshot_(context, [this] { snapshot_.Arm(8000); }),
+        sync_interest_(context, [this] { SyncInterestTimeout(); }),
+        sync_duration_(context, [this] { sync_interest_.Cancel(); }),
+        dt_(context, [] {}),
+        wt_(context, [] {}) {
+    state_.Arm(kSyncDelay);
+    publish_.Arm(std::uniform_int_distribution<uint64_t>(1000, 8000)(rengine_));
+    snapshot_.Arm(3000);
+  }
+
+  bool awake = false;
+
+  void OnOverheard() {
+    dt_.Cancel();
+    wt_.Cancel();
+    wt_.Arm(23);
+  }
+
+  void OnSend() {
+    dt_.Arm(std::uniform_int_distribution<uint64_t>(0, 20)(rengine_));
+    wt_.Arm(23);
+  }
+
+ private:
+  void CheckState() {
+    state_.Arm(kSyncDelay);
+    slot_++;
+    uint64_t offset = (nid_ % kGroupSize + kGroupSize - slot_ % kGroupSize) % kGroupSize;
+    awake = offset < kActive;
+    if (offset == 0) {
+      sync_duration_.Arm(150);
+      sync_interest_.Arm(23);
+    }
+    if (!awake) {
+      dt_.Cancel();
+      wt_.Cancel();
+    }
+  }
+
+  void Publish() {
+    publish_.Arm(std::uniform_int_distribution<uint64_t>(1000, 8000)(rengine_));
+  }
+
+  void SyncInterestTimeout() {
+    sync_interest_.Arm(23);
+  }
+
+  uint64_t nid_;
+  std::mt19937& rengine_;
+  uint64_t slot_ = 0;
+  Timer state_;
+  Timer publish_;
+  Timer snapshot_;
+  Timer sync_interest_;
+  Timer sync_duration_;
+  Timer dt_;
+  Timer wt_;
+};
+
+struct Result {
+  uint64_t ops;
+  uint64_t popped;
+  uint64_t handled;
+  double seconds;
+};
+
+// the interests of a group, one every 1-23 ms
+template <class Node>
+static void ScheduleInterest(Simulation& sim, std::vector<std::unique_ptr<Node>>& nodes, uint64_t group,
+                             std::mt19937& rengine) {
+  sim.Insert(sim.now + std::uniform_int_distribution<uint64_t>(1, 23)(rengine), [&sim, &nodes, group, &rengine] {
+    sim.packets++;
+    std::vector<Node*> awake;
+    for (uint64_t i = group * kGroupSize; i < (group + 1) * kGroupSize && i < nodes.size(); ++i) {
+      if (nodes[i]->awake) awake.push_back(nodes[i].get());
+    }
+    if (!awake.empty()) {
+      Node* sender = awake[std::uniform_int_distribution<size_t>(0, awake.size() - 1)(rengine)];
+      sender->OnSend();
+      // the interest, then its data
+      for (int packet = 0; packet < 2; ++packet) {
+        for (Node* node : awake) {
+          if (node != sender) node->OnOverheard();
+        }
+      }
+    }
+    ScheduleInterest(sim, nodes, group, rengine);
+  });
+}
+
+static Result RunSet(uint64_t node_num) {
+  Simulation sim;
+  std::mt19937 rengine(1);
+  using Node = BenchNode<SetTimer, Simulation>;
+  std::vector<std::unique_ptr<Node>> nodes;
+  for (uint64_t nid = 0; nid < node_num; ++nid) nodes.emplace_back(new Node(sim, nid, rengine));
+  for (uint64_t group = 0; group * kGroupSize < node_num; ++group) ScheduleInterest(sim, nodes, group, rengine);
+  auto start = std::chrono::steady_clock::now();
+  sim.Run(kSimulated);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return Result{sim.ops, sim.events, sim.events, seconds};
+}
+
+static Result RunWheel(uint64_t node_num) {
+  Simulation sim;
+  std::mt19937 rengine(1);
+  using Node = BenchNode<WheelTimer, SimulatedWheel>;
+  std::vector<std::unique_ptr<SimulatedWheel>> wheels;
+  std::vector<std::unique_ptr<Node>> nodes;
+  for (uint64_t nid = 0; nid < node_num; ++nid) {
+    wheels.emplace_back(new SimulatedWheel(sim));
+    nodes.emplace_back(new Node(*wheels.back(), nid, rengine));
+  }
+  for (uint64_t group = 0; group * kGroupSize < node_num; ++group) ScheduleInterest(sim, nodes, group, rengine);
+  auto start = std::chrono::steady_clock::now();
+  sim.Run(kSimulated);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  uint64_t handled = sim.packets;
+  for (const auto& wheel : wheels) handled += wheel->GetFiredNum();
+  nodes.clear();
+  return Result{sim.ops, sim.events, handled, seconds};
+}
+
+int main() {
+  std::cout << std::setw(8) << "nodes" << std::setw(8) << "timers" << std::setw(12) << "set ops"
+            << std::setw(12) << "popped" << std::setw(12) << "handled" << std::setw(12) << "Mevents/s"
+            << std::setw(16) << "ms wall/sim s"
+            << "\n";
+  for (uint64_t node_num : {100, 500, 1000}) {
+    Result set = RunSet(node_num);
+    Result wheel = RunWheel(node_num);
+    for (int variant = 0; variant < 2; ++variant) {
+      const Result& r = variant == 0 ? set : wheel;
+      std::cout << std::setw(8) << node_num << std::setw(8) << (variant == 0 ? "set" : "wheel")
+                << std::setw(12) << r.ops << std::setw(12) << r.popped << std::setw(12) << r.handled
+                << std::fixed << std::setprecision(2) << std::setw(12) << r.handled / r.seconds / 1e6
+                << std::setw(16) << r.seconds * 1000 / (kSimulated / 1000) << "\n";
+    }
+  }
+  return 0;
+}
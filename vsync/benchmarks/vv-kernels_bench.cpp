@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+// Compares the scalar and AVX2 version vector kernels.
+//
+// Usage: vv-kernels-bench [iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "vv-kernels.hpp"
+
+using namespace ndn::vsync;
+
+template <typename F>
+static double NsPerCall(F f, size_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  std::cout << "AVX2 " << (vv_kernels::HasAVX2() ? "available" : "not available") << "\n";
+  std::cout << std::setw(6) << "size" << std::setw(16) << "merge scalar" << std::setw(16) << "merge avx2"
+            << std::setw(16) << "cmp scalar" << std::setw(16) << "cmp avx2" << "   (ns/call)\n";
+
+  std::mt19937 rengine(1);
+  std::uniform_int_distribution<uint64_t> rdist(0, 100000);
+  for (size_t n : {8, 16, 32, 64, 128, 256, 1024}) {
+    VersionVector l(n), r(n), out(n);
+    for (size_t i = 0; i < n; ++i) l[i] = r[i] = rdist(rengine);
+    // equal vectors are the worst case for compare: no early exit
+    volatile unsigned sink = 0;
+
+    double merge_scalar = NsPerCall([&] { vv_kernels::MergeScalar(out.data(), l.data(), r.data(), n); }, iterations);
+    double merge_avx2 = NsPerCall([&] { vv_kernels::MergeAVX2(out.data(), l.data(), r.data(), n); }, iterations);
+    double cmp_scalar = NsPerCall([&] { sink = vv_kernels::CompareScalar(l.data(), r.data(), n); }, iterations);
+    double cmp_avx2 = NsPerCall([&] { sink = vv_kernels::CompareAVX2(l.data(), r.data(), n); }, iterations);
+    (void)sink;
+
+    std::cout << std::setw(6) << n << std::fixed << std::setprecision(2)
+              << std::setw(16) << merge_scalar << std::setw(16) << merge_avx2
+              << std::setw(16) << cmp_scalar << std::setw(16) << cmp_avx2 << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,44 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "adaptive-timer.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace vsync {
+
+const double AdaptiveTimer::kMinDT = 5;
+const double AdaptiveTimer::kMaxDT = 60;
+const double AdaptiveTimer::kStep = 2;
+const double AdaptiveTimer::kHighLoss = 0.2;
+const double AdaptiveTimer::kLowLoss = 0.05;
+const double AdaptiveTimer::kGain = 0.25;
+
+AdaptiveTimer::AdaptiveTimer(double dt, double transmission_time)
+    : dt_(std::min(kMaxDT, std::max(kMinDT, dt))),
+      transmission_time_(transmission_time),
+      loss_rate_(0),
+      responders_(0),
+      slot_num_(0) {
+}
+
+void AdaptiveTimer::OnSlot(const Slot& slot) {
+  if (slot.sent == 0 && slot.responders == 0) return;
+  slot_num_++;
+
+  if (slot.sent > 0) {
+    double loss = std::min(1.0, static_cast<double>(slot.collisions + slot.timeouts) / slot.sent);
+    loss_rate_ += kGain * (loss - loss_rate_);
+  }
+  if (slot.responders > 0) responders_ += kGain * (slot.responders - responders_);
+
+  if (loss_rate_ > kHighLoss) dt_ *= 1.5;
+  // suppressed interests are the window doing its job: only shrink it when
+  // the responders neither collide nor defer to each other
+  else if (loss_rate_ < kLowLoss && slot.suppressions == 0) dt_ -= kStep;
+  dt_ = std::max(dt_, responders_ * transmission_time_);
+  dt_ = std::min(kMaxDT, std::max(kMinDT, dt_));
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_ADAPTIVE_TIMER_HPP_
+#define NDN_VSYNC_ADAPTIVE_TIMER_HPP_
+
+#include <cstdint>
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Deferral window of the responders, sized from the contention they see.
+ *
+ * Every responder waits a random DT in [0, DT max] before sending an
+ * interest, so that the first one to send suppresses the others, and gives a
+ * request WT = DT max + one transmission time to be answered. Too narrow a
+ * window and the responders of a sync send together: their interests
+ * collide and are retransmitted, or time out. Too wide and every sync waits
+ * longer than it needs to.
+ *
+ * At the end of every sync slot the node reports what it saw in it. The
+ * share of its interests that were retransmitted or timed out is smoothed
+ * over the slots; the window grows by half when that loss rate exceeds
+ * kHighLoss and shrinks by kStep when it is below kLowLoss. The window never
+ * gets narrower than one transmission time per responder announced in the
+ * SyncACKs of the slot (also smoothed), nor leaves [kMinDT, kMaxDT]; the
+ * upper bound keeps a few waits within the sync duration.
+ */
+class AdaptiveTimer {
+ public:
+  static const double kMinDT;
+  static const double kMaxDT;
+  static const double kStep;
+  static const double kHighLoss;
+  static const double kLowLoss;
+  // weight of the latest slot in the smoothed loss rate and responder number
+  static const double kGain;
+
+  struct Slot {
+    uint64_t sent;          // interests sent
+    uint64_t collisions;    // of them, retransmissions
+    uint64_t timeouts;      // of them, fetches that timed out
+    uint64_t suppressions;  // interests of other nodes joined instead of sent
+    uint64_t responders;    // distinct responders heard in SyncACKs
+  };
+
+  /**
+   * @param dt                 Initial DT max, in milliseconds
+   * @param transmission_time  Airtime of one interest, in milliseconds
+   */
+  explicit AdaptiveTimer(double dt, double transmission_time = 3);
+
+  // slots in which the node neither sent nor heard anything are skipped
+  void OnSlot(const Slot& slot);
+
+  // in milliseconds
+  double DT() const { return dt_; }
+  double WT() const { return dt_ + transmission_time_; }
+  // the lifetime of the interests joined on behalf of another node covers
+  // its wait and ours
+  double PitLifetime() const { return 2 * WT() + 8; }
+
+  double LossRate() const { return loss_rate_; }
+  double Responders() const { return responders_; }
+  uint64_t SlotNum() const { return slot_num_; }
+
+ private:
+  double dt_;
+  double transmission_time_;
+  double loss_rate_;
+  double responders_;
+  uint64_t slot_num_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_ADAPTIVE_TIMER_HPP_
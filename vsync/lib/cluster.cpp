@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "cluster.hpp"
+
+namespace ndn {
+namespace vsync {
+
+std::shared_ptr<Data> UnwrapRelayedData(const Data& data) {
+  if (data.getContentType() != Node::kRelayedData) return nullptr;
+  const auto& content = data.getContent();
+  try {
+    return std::make_shared<Data>(Block(content.value(), content.value_size()));
+  }
+  catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+ClusterHead::ClusterHead(Device& device, const Name& prefix, const GroupID& gid, uint64_t cluster,
+                         uint64_t cluster_num, const NodeID& nid, uint64_t cluster_size)
+    : cluster_node_(device, nid, prefix, MakeClusterGroupID(gid, cluster), cluster_size, [] (const VersionVector&) {}),
+      backbone_node_(device, cluster, prefix, MakeBackboneGroupID(gid), cluster_num, [] (const VersionVector&) {}),
+      relayed_up_num_(0),
+      relayed_down_num_(0) {
+  // the backbone only carries what the heads relay
+  backbone_node_.SetPublishRate(0, 0);
+  cluster_node_.SetNewDataCallback([this] (NodeID, uint64_t, const Data& data) { OnClusterData(data); });
+  backbone_node_.SetNewDataCallback([this] (NodeID nid, uint64_t, const Data& data) { OnBackboneData(nid, data); });
+}
+
+void ClusterHead::OnClusterData(const Data& data) {
+  // what we relay into the cluster came from the backbone
+  if (data.getContentType() == Node::kRelayedData) return;
+  const Block& wire = data.wireEncode();
+  backbone_node_.PublishRelayed(wire.wire(), wire.size());
+  relayed_up_num_++;
+}
+
+void ClusterHead::OnBackboneData(NodeID nid, const Data& data) {
+  // our own relays are already in the cluster
+  if (nid == backbone_node_.GetNodeID()) return;
+  const auto& content = data.getContent();
+  cluster_node_.PublishRelayed(content.value(), content.value_size());
+  relayed_down_num_++;
+}
+
+}  // namespace vsync
+}  // namespace ndn
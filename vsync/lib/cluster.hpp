@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_CLUSTER_HPP_
+#define NDN_VSYNC_CLUSTER_HPP_
+
+#include <memory>
+
+#include "device.hpp"
+#include "node.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Two-level sync for groups that span several radio neighbourhoods.
+ *
+ * The members are split into spatial clusters. Each cluster is a group of
+ * its own, whose version vector only covers its members. One member of every
+ * cluster, its head, is also a member of the backbone group of all the
+ * heads. The head relays every object published in its cluster to the
+ * backbone, and every object of the other clusters into its cluster. A relay
+ * is a publication of the head of type Node::kRelayedData, whose content is
+ * the wire encoding of the original Data.
+ *
+ * The backbone entry of a head therefore counts the objects of its whole
+ * cluster: it aggregates the cluster's vector. Backbone vectors have one
+ * entry per cluster, and cluster vectors one entry per cluster member,
+ * instead of one entry per member of the whole group.
+ */
+
+// group ID of cluster @p cluster of group @p gid, and of its backbone
+inline GroupID MakeClusterGroupID(const GroupID& gid, uint64_t cluster) {
+  return gid + "-c" + to_string(cluster);
+}
+
+inline GroupID MakeBackboneGroupID(const GroupID& gid) {
+  return gid + "-backbone";
+}
+
+// the original Data of an object of type Node::kRelayedData, or null
+std::shared_ptr<Data> UnwrapRelayedData(const Data& data);
+
+class ClusterHead {
+ public:
+  /**
+   * @param device        Device of the head, in no group yet
+   * @param gid           ID of the whole group
+   * @param cluster       Index of the head's cluster, its ID in the backbone
+   * @param cluster_num   Number of clusters, the size of the backbone
+   * @param nid           ID of the head in its cluster
+   * @param cluster_size  Number of members of the cluster
+   */
+  ClusterHead(Device& device, const Name& prefix, const GroupID& gid, uint64_t cluster, uint64_t cluster_num,
+              const NodeID& nid, uint64_t cluster_size);
+
+  Node& GetClusterNode() { return cluster_node_; }
+  Node& GetBackboneNode() { return backbone_node_; }
+
+  // objects relayed from the cluster to the backbone, and back
+  uint64_t GetRelayedUpNum() const { return relayed_up_num_; }
+  uint64_t GetRelayedDownNum() const { return relayed_down_num_; }
+
+ private:
+  void OnClusterData(const Data& data);
+  void OnBackboneData(NodeID nid, const Data& data);
+
+ private:
+  Node cluster_node_;
+  Node backbone_node_;
+  uint64_t relayed_up_num_;
+  uint64_t relayed_down_num_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_CLUSTER_HPP_
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "data-log.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace vsync {
+
+namespace {
+
+const uint32_t kRecordMagic = 0x7673796e;  // "vsyn"
+const uint8_t kDataTlvType = 0x06;
+
+// the magic is written last, so a record without it was torn by a crash
+struct RecordHeader {
+  uint32_t magic;
+  uint32_t size;  // of the wire encoding that follows
+  uint64_t nid;
+  uint64_t seq;
+  uint32_t content_type;
+  uint32_t reserved;
+};
+
+// records start on 8-byte boundaries
+inline size_t Align(size_t n) {
+  return (n + 7) & ~static_cast<size_t>(7);
+}
+
+std::string SegmentPath(const std::string& dir, uint32_t index) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "/segment-%06u.log", index);
+  return dir + name;
+}
+
+}  // namespace
+
+DataLog::DataLog(const std::string& dir, size_t segment_size)
+    : dir_(dir), segment_size_(segment_size), size_(0), segment_num_(0) {
+  if (::mkdir(dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw Error("Cannot create data log directory " + dir_ + ": " + std::strerror(errno));
+  }
+  // reclaimed segments leave gaps in the numbering
+  DIR* d = ::opendir(dir_.c_str());
+  if (d == nullptr) {
+    throw Error("Cannot read data log directory " + dir_ + ": " + std::strerror(errno));
+  }
+  std::vector<uint32_t> indices;
+  while (struct dirent* entry = ::readdir(d)) {
+    unsigned index;
+    int end = 0;
+    if (std::sscanf(entry->d_name, "segment-%6u.log%n", &index, &end) == 1 &&
+        end > 0 && entry->d_name[end] == '\0') {
+      indices.push_back(index);
+    }
+  }
+  ::closedir(d);
+  std::sort(indices.begin(), indices.end());
+  for (uint32_t i: indices) {
+    OpenSegment(i, false);
+    Scan(i);
+  }
+  if (segments_.empty()) OpenSegment(0, true);
+}
+
+DataLog::~DataLog() {
+  for (auto& s: segments_) CloseSegment(s);
+}
+
+void DataLog::OpenSegment(uint32_t index, bool create) {
+  auto path = SegmentPath(dir_, index);
+  int fd = ::open(path.c_str(), create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR, 0644);
+  if (fd < 0) {
+    throw Error("Cannot open data log segment " + path + ": " + std::strerror(errno));
+  }
+  // segments are preallocated (zero-filled), so they never have to be
+  // remapped; one written with a larger segment size keeps its size
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw Error("Cannot stat data log segment " + path + ": " + std::strerror(errno));
+  }
+  size_t size = std::max(static_cast<size_t>(st.st_size), segment_size_);
+  if (static_cast<size_t>(st.st_size) < size && ::ftruncate(fd, size) != 0) {
+    ::close(fd);
+    throw Error("Cannot size data log segment " + path + ": " + std::strerror(errno));
+  }
+  void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    ::close(fd);
+    throw Error("Cannot map data log segment " + path + ": " + std::strerror(errno));
+  }
+  if (index >= segments_.size()) segments_.resize(index + 1, Segment{-1, nullptr, 0, 0});
+  segments_[index] = Segment{fd, static_cast<uint8_t*>(base), size, 0};
+  segment_num_++;
+}
+
+void DataLog::CloseSegment(Segment& s) {
+  if (s.base == nullptr) return;
+  ::munmap(s.base, s.size);
+  ::close(s.fd);
+  s = Segment{-1, nullptr, 0, 0};
+}
+
+template <class F>
+void DataLog::ForEachRecord(const Segment& s, const F& f) const {
+  size_t offset = 0;
+  while (offset < s.used) {
+    RecordHeader h;
+    std::memcpy(&h, s.base + offset, sizeof(h));
+    f(h);
+    offset = Align(offset + sizeof(RecordHeader) + h.size);
+  }
+}
+
+void DataLog::Scan(uint32_t index) {
+  auto& s = segments_[index];
+  while (s.used + sizeof(RecordHeader) <= s.size) {
+    RecordHeader h;
+    std::memcpy(&h, s.base + s.used, sizeof(h));
+    size_t wire_offset = s.used + sizeof(RecordHeader);
+    if (h.magic != kRecordMagic || h.size == 0 || h.size > s.size - wire_offset ||
+        s.base[wire_offset] != kDataTlvType) {
+      break;
+    }
+    Index(h.nid, h.seq, Location{index, static_cast<uint32_t>(wire_offset), h.size});
+    s.used = Align(wire_offset + h.size);
+  }
+}
+
+void DataLog::Index(NodeID nid, uint64_t seq, const Location& loc) {
+  auto& last = segments_[loc.segment].last;
+  if (nid >= last.size()) last.resize(nid + 1, 0);
+  last[nid] = std::max(last[nid], seq);
+  if (nid >= index_.size()) index_.resize(nid + 1);
+  auto& p = index_[nid];
+  if (seq > p.size()) p.resize(seq, Location{0, 0, 0});
+  if (p[seq - 1].size == 0) size_++;
+  p[seq - 1] = loc;
+}
+
+bool DataLog::Append(NodeID nid, uint64_t seq, const Block& wire, uint32_t content_type) {
+  if (seq == 0 || Has(nid, seq)) return false;
+  size_t record_size = sizeof(RecordHeader) + wire.size();
+  if (record_size > segment_size_) return false;
+  if (segments_.back().used + record_size > segments_.back().size) {
+    OpenSegment(segments_.size(), true);
+  }
+
+  uint32_t index = segments_.size() - 1;
+  auto& s = segments_.back();
+  uint8_t* record = s.base + s.used;
+  std::memcpy(record + sizeof(RecordHeader), wire.wire(), wire.size());
+  RecordHeader h{0, static_cast<uint32_t>(wire.size()), nid, seq, content_type, 0};
+  std::memcpy(record, &h, sizeof(h));
+  __atomic_store_n(reinterpret_cast<uint32_t*>(record), kRecordMagic, __ATOMIC_RELEASE);
+
+  Index(nid, seq, Location{index, static_cast<uint32_t>(s.used + sizeof(RecordHeader)),
+                           static_cast<uint32_t>(wire.size())});
+  s.used = Align(s.used + record_size);
+  return true;
+}
+
+std::pair<const uint8_t*, size_t> DataLog::Find(NodeID nid, uint64_t seq) const {
+  if (nid >= index_.size() || seq == 0 || seq > index_[nid].size()) return {nullptr, 0};
+  const auto& loc = index_[nid][seq - 1];
+  if (loc.size == 0) return {nullptr, 0};
+  return {segments_[loc.segment].base + loc.offset, loc.size};
+}
+
+std::pair<const uint8_t*, size_t> DataLog::Find(NodeID nid, uint64_t seq, uint32_t& content_type) const {
+  auto wire = Find(nid, seq);
+  if (wire.first != nullptr) {
+    RecordHeader h;
+    std::memcpy(&h, wire.first - sizeof(RecordHeader), sizeof(h));
+    content_type = h.content_type;
+  }
+  return wire;
+}
+
+void DataLog::ForEach(const std::function<void(NodeID, uint64_t)>& f) const {
+  for (NodeID nid = 0; nid < index_.size(); ++nid) {
+    for (uint64_t seq = 1; seq <= index_[nid].size(); ++seq) {
+      if (index_[nid][seq - 1].size != 0) f(nid, seq);
+    }
+  }
+}
+
+size_t DataLog::Reclaim(const std::function<uint64_t(NodeID)>& horizon) {
+  size_t reclaimed = 0;
+  for (uint32_t index = 0; index + 1 < segments_.size(); ++index) {
+    auto& s = segments_[index];
+    if (s.base == nullptr) continue;
+    bool evicted = true;
+    for (NodeID nid = 0; nid < s.last.size() && evicted; ++nid) {
+      if (s.last[nid] != 0 && s.last[nid] >= horizon(nid)) evicted = false;
+    }
+    if (!evicted) continue;
+    ForEachRecord(s, [&] (const RecordHeader& h) {
+      auto& loc = index_[h.nid][h.seq - 1];
+      if (loc.size != 0 && loc.segment == index) {
+        loc = Location{0, 0, 0};
+        size_--;
+      }
+    });
+    CloseSegment(s);
+    ::unlink(SegmentPath(dir_, index).c_str());
+    segment_num_--;
+    reclaimed++;
+  }
+  return reclaimed;
+}
+
+void DataLog::Sync() {
+  for (auto& s: segments_) {
+    if (s.base != nullptr) ::msync(s.base, s.used, MS_SYNC);
+  }
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_DATA_LOG_HPP_
+#define NDN_VSYNC_DATA_LOG_HPP_
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ndn-cxx/encoding/block.hpp>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * @brief Append-only log of wire-encoded Data, kept in memory-mapped segment
+ *        files under one directory.
+ *
+ * Each record is a small header carrying the (producer, sequence number) and
+ * the content type of the Data followed by its wire encoding, so a Data can
+ * be served straight from the mapping without decoding it. The log has no separate index file: opening a directory
+ * scans every segment and rebuilds the (producer, sequence number) index,
+ * stopping at the first record that was not completely written.
+ *
+ * The log does not know the retention policy of the data store; its owner
+ * hides the objects the store evicted and calls Reclaim() to delete the
+ * segments that hold nothing else.
+ */
+class DataLog {
+ public:
+  class Error : public std::runtime_error {
+   public:
+    explicit Error(const std::string& what) : std::runtime_error(what) {}
+  };
+
+  static const size_t kDefaultSegmentSize = 4 * 1024 * 1024;
+
+  /**
+   * @brief Opens (or creates) the log in directory @p dir and rebuilds the
+   *        index from its segments.
+   *
+   * @throw Error if the directory or a segment cannot be created or mapped
+   */
+  explicit DataLog(const std::string& dir, size_t segment_size = kDefaultSegmentSize);
+
+  ~DataLog();
+
+  /**
+   * @brief   Appends @p wire as object @p seq of producer @p nid, whose
+   *          ContentType is @p content_type.
+   *
+   * @return  false if the object is already logged, @p seq is 0 or the
+   *          record does not fit in a segment.
+   * @throw   Error if a new segment cannot be created
+   */
+  bool Append(NodeID nid, uint64_t seq, const Block& wire, uint32_t content_type = 0);
+
+  /**
+   * @brief   Returns the wire encoding of object @p seq of producer @p nid
+   *          inside the mapping, or {nullptr, 0} if it is not logged.
+   */
+  std::pair<const uint8_t*, size_t> Find(NodeID nid, uint64_t seq) const;
+
+  // the same, also reading the content type of the object from its record
+  std::pair<const uint8_t*, size_t> Find(NodeID nid, uint64_t seq, uint32_t& content_type) const;
+
+  bool Has(NodeID nid, uint64_t seq) const {
+    return Find(nid, seq).first != nullptr;
+  }
+
+  // calls @p f(nid, seq) for every logged object
+  void ForEach(const std::function<void(NodeID, uint64_t)>& f) const;
+
+  /**
+   * @brief   Deletes the segments, except the one being appended to, whose
+   *          objects are all below @p horizon(nid) of their producer.
+   *
+   * @return  The number of segments deleted.
+   */
+  size_t Reclaim(const std::function<uint64_t(NodeID)>& horizon);
+
+  // flushes the mapped segments to disk
+  void Sync();
+
+  // number of logged objects
+  size_t Size() const {
+    return size_;
+  }
+
+  // number of segments on disk
+  size_t SegmentNum() const {
+    return segment_num_;
+  }
+
+ private:
+  DataLog(const DataLog&) = delete;
+  DataLog& operator=(const DataLog&) = delete;
+
+  // a reclaimed segment keeps its place, with base == nullptr
+  struct Segment {
+    int fd;
+    uint8_t* base;
+    size_t size;  // of the mapping, at least the segment size of the log
+    size_t used;  // offset of the next record
+    std::vector<uint64_t> last;  // [nid] highest sequence number, 0 if none
+  };
+
+  // position of a record; size == 0 means not logged
+  struct Location {
+    uint32_t segment;
+    uint32_t offset;  // of the wire encoding
+    uint32_t size;
+  };
+
+  void OpenSegment(uint32_t index, bool create);
+  void CloseSegment(Segment& s);
+  void Scan(uint32_t index);
+  void Index(NodeID nid, uint64_t seq, const Location& loc);
+  // calls @p f(header) for every record of segment @p s
+  template <class F>
+  void ForEachRecord(const Segment& s, const F& f) const;
+
+  std::string dir_;
+  size_t segment_size_;
+  std::vector<Segment> segments_;
+  std::vector<std::vector<Location>> index_;  // [nid][seq - 1]
+  size_t size_;
+  size_t segment_num_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_DATA_LOG_HPP_
@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_DATA_STORE_HPP_
+#define NDN_VSYNC_DATA_STORE_HPP_
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * @brief Store of the group's data, indexed by (producer, sequence number).
+ *
+ * Each producer has a contiguous run of slots covering [base, base + size),
+ * so a lookup is two array indexings instead of hashing a whole Name.
+ * Sequence numbers start at 1 and arrive almost in order, so the runs are
+ * dense in practice; missing objects are just empty slots.
+ *
+ * The store can be bounded by a byte budget and a maximum age. With a maximum
+ * age, every object expires after its freshness period, capped by that age;
+ * without one, objects never expire and only the byte budget drops them, in
+ * insertion order. The objects are threaded through intrusive FIFO queues,
+ * one per lifetime, so both limits are enforced by popping the queue head
+ * that expires first.
+ * Objects of the same lifetime expire in the order they were inserted, so a
+ * new object goes to the tail of its queue in O(1); a group uses one or two
+ * lifetimes, so finding the first head is O(1) too.
+ *
+ * Eviction always drops a prefix of a producer's sequence numbers: the
+ * retention horizon of a producer is the first sequence number that may
+ * still be stored, and objects below it are refused. So are objects more
+ * than kMaxSeqGap away from the stored run of their producer, so that one
+ * object never adds more than that many empty slots.
+ */
+class DataStore {
+ public:
+  using TimePoint = time::system_clock::time_point;
+
+  /**
+   * @param group_size  Initial number of producers
+   * @param max_bytes   Byte budget of the wire-encoded objects, 0 for none
+   * @param max_age     Upper bound on the lifetime of an object, 0 for none;
+   *                    freshness periods only expire objects when it is set
+   */
+  explicit DataStore(size_t group_size = 0, size_t max_bytes = 0,
+                     time::milliseconds max_age = time::milliseconds(0))
+      : producers_(group_size), max_bytes_(max_bytes), max_age_(max_age),
+        size_(0), bytes_(0), peak_bytes_(0), evicted_(0) {}
+
+  void SetRetention(size_t max_bytes, time::milliseconds max_age) {
+    max_bytes_ = max_bytes;
+    max_age_ = max_age;
+  }
+
+  /**
+   * @brief   Stores @p data as object @p seq of producer @p nid, then evicts
+   *          the objects closest to expiry until the byte budget is met.
+   *          @p data must be signed: its wire encoding counts against the
+   *          budget.
+   *
+   * @return  false if the slot is already occupied, @p seq is 0, @p seq is
+   *          below the retention horizon of @p nid or too far from its stored
+   *          run, or the byte budget evicted the object right away.
+   */
+  bool Insert(NodeID nid, uint64_t seq, std::shared_ptr<const Data> data,
+              TimePoint now = time::system_clock::now()) {
+    if (seq == 0) return false;
+    if (nid >= producers_.size()) producers_.resize(nid + 1);
+    auto& p = producers_[nid];
+    if (seq < p.horizon) return false;
+    if (!p.slots.empty() && (seq < p.base ? p.base - seq > kMaxSeqGap
+                                          : seq - p.base >= p.slots.size() + kMaxSeqGap)) {
+      return false;
+    }
+    if (p.slots.empty()) p.base = seq;
+    if (seq < p.base) {
+      p.slots.insert(p.slots.begin(), p.base - seq, Entry());
+      p.base = seq;
+    }
+    size_t index = seq - p.base;
+    if (index >= p.slots.size()) p.slots.resize(index + 1);
+    auto& e = p.slots[index];
+    if (e.data) return false;
+
+    time::milliseconds lifetime(0);
+    if (max_age_ > time::milliseconds(0)) {
+      lifetime = data->getFreshnessPeriod();
+      if (lifetime <= time::milliseconds(0) || lifetime > max_age_) lifetime = max_age_;
+    }
+    e.expiry = lifetime > time::milliseconds(0) ? now + lifetime : TimePoint::max();
+    e.bytes = data->wireEncode().size();
+    bytes_ += e.bytes;
+    peak_bytes_ = std::max(peak_bytes_, bytes_);
+    e.data = std::move(data);
+    size_++;
+    Link(Key{nid, seq}, lifetime);
+
+    while (max_bytes_ > 0 && bytes_ > max_bytes_) {
+      Key head = Head();
+      if (head.seq == 0) break;
+      EvictUpTo(head.nid, head.seq);
+    }
+    return seq >= p.horizon;
+  }
+
+  /**
+   * @brief   Drops every object of producer @p nid with sequence number up to
+   *          and including @p seq, and moves the retention horizon of @p nid
+   *          past @p seq.
+   *
+   * @return  The number of objects dropped.
+   */
+  size_t EvictUpTo(NodeID nid, uint64_t seq) {
+    if (nid >= producers_.size()) return 0;
+    auto& p = producers_[nid];
+    if (seq < p.horizon) return 0;
+    p.horizon = seq + 1;
+    size_t dropped = 0;
+    while (!p.slots.empty() && p.base <= seq) {
+      if (p.slots.front().data) {
+        Unlink(Key{nid, p.base});
+        bytes_ -= p.slots.front().bytes;
+        size_--;
+        dropped++;
+      }
+      p.slots.pop_front();
+      p.base++;
+    }
+    if (p.slots.empty()) p.base = p.horizon;
+    evicted_ += dropped;
+    return dropped;
+  }
+
+  /**
+   * @brief   Drops the objects that expired at or before @p now, together
+   *          with the older objects of the same producers.
+   *
+   * @return  The number of objects dropped.
+   */
+  size_t Expire(TimePoint now = time::system_clock::now()) {
+    size_t dropped = 0;
+    for (Key head = Head(); head.seq != 0 && At(head).expiry <= now; head = Head()) {
+      dropped += EvictUpTo(head.nid, head.seq);
+    }
+    return dropped;
+  }
+
+  const std::shared_ptr<const Data>& Find(NodeID nid, uint64_t seq) const {
+    static const std::shared_ptr<const Data> kNone;
+    if (nid >= producers_.size()) return kNone;
+    const auto& p = producers_[nid];
+    if (seq < p.base || seq - p.base >= p.slots.size()) return kNone;
+    return p.slots[seq - p.base].data;
+  }
+
+  bool Has(NodeID nid, uint64_t seq) const {
+    return Find(nid, seq) != nullptr;
+  }
+
+  // first sequence number of producer @p nid that has not been evicted
+  uint64_t RetentionHorizon(NodeID nid) const {
+    return nid < producers_.size() ? producers_[nid].horizon : 1;
+  }
+
+  // number of stored objects
+  size_t Size() const {
+    return size_;
+  }
+
+  // wire-encoded bytes of the stored objects
+  size_t Bytes() const {
+    return bytes_;
+  }
+
+  size_t PeakBytes() const {
+    return peak_bytes_;
+  }
+
+  // total number of objects dropped by eviction
+  size_t Evicted() const {
+    return evicted_;
+  }
+
+ private:
+  // position of an object in the store; seq == 0 means none
+  struct Key {
+    NodeID nid;
+    uint64_t seq;
+  };
+
+  struct Entry {
+    std::shared_ptr<const Data> data;
+    TimePoint expiry;
+    size_t bytes = 0;  // of the wire encoding
+    size_t queue = 0;  // expiry queue of its lifetime
+    Key prev{0, 0};  // neighbours in the expiry queue
+    Key next{0, 0};
+  };
+
+  // the objects of one lifetime, in expiry order
+  struct Queue {
+    time::milliseconds lifetime;
+    Key head{0, 0};  // expires first
+    Key tail{0, 0};
+  };
+
+  struct Producer {
+    uint64_t base = 1;  // sequence number of slots.front()
+    uint64_t horizon = 1;  // sequence numbers below this were evicted
+    std::deque<Entry> slots;
+  };
+
+  Entry& At(const Key& k) {
+    auto& p = producers_[k.nid];
+    return p.slots[k.seq - p.base];
+  }
+
+  // the object that expires first, seq == 0 if none
+  Key Head() {
+    Key head{0, 0};
+    for (const auto& q: queues_) {
+      if (q.head.seq != 0 && (head.seq == 0 || At(q.head).expiry < At(head).expiry)) head = q.head;
+    }
+    return head;
+  }
+
+  // append @p k to the expiry queue of @p lifetime; a clock that went back
+  // makes it search backwards from the tail
+  void Link(const Key& k, time::milliseconds lifetime) {
+    size_t index = 0;
+    while (index < queues_.size() && queues_[index].lifetime != lifetime) index++;
+    if (index == queues_.size()) queues_.push_back(Queue{lifetime});
+    Queue& q = queues_[index];
+    Entry& e = At(k);
+    e.queue = index;
+    Key pos = q.tail;
+    while (pos.seq != 0 && At(pos).expiry > e.expiry) pos = At(pos).prev;
+    e.prev = pos;
+    e.next = pos.seq != 0 ? At(pos).next : q.head;
+    if (e.next.seq != 0) At(e.next).prev = k;
+    else q.tail = k;
+    if (pos.seq != 0) At(pos).next = k;
+    else q.head = k;
+  }
+
+  void Unlink(const Key& k) {
+    Entry& e = At(k);
+    Queue& q = queues_[e.queue];
+    if (e.prev.seq != 0) At(e.prev).next = e.next;
+    else q.head = e.next;
+    if (e.next.seq != 0) At(e.next).prev = e.prev;
+    else q.tail = e.prev;
+  }
+
+  std::vector<Producer> producers_;
+  std::vector<Queue> queues_;
+  size_t max_bytes_;
+  time::milliseconds max_age_;
+  size_t size_;
+  size_t bytes_;
+  size_t peak_bytes_;
+  size_t evicted_;
+};
+
+/**
+ * @brief The objects of one group in a DataStore that may be shared by the
+ *        groups of a device (see Device).
+ *
+ * Producer nid of the group is producer base + nid of the store, so the
+ * groups have one byte budget and one expiry queue: eviction drops the
+ * objects closest to expiry whatever their group. Size and byte counts are
+ * those of the whole store.
+ */
+class GroupDataStore {
+ public:
+  using TimePoint = DataStore::TimePoint;
+
+  // a store of its own
+  explicit GroupDataStore(size_t group_size = 0, size_t max_bytes = 0,
+                          time::milliseconds max_age = time::milliseconds(0))
+      : store_(std::make_shared<DataStore>(group_size, max_bytes, max_age)), base_(0) {}
+
+  GroupDataStore(std::shared_ptr<DataStore> store, NodeID base)
+      : store_(std::move(store)), base_(base) {}
+
+  void SetRetention(size_t max_bytes, time::milliseconds max_age) {
+    store_->SetRetention(max_bytes, max_age);
+  }
+
+  bool Insert(NodeID nid, uint64_t seq, std::shared_ptr<const Data> data,
+              TimePoint now = time::system_clock::now()) {
+    return store_->Insert(base_ + nid, seq, std::move(data), now);
+  }
+
+  size_t EvictUpTo(NodeID nid, uint64_t seq) {
+    return store_->EvictUpTo(base_ + nid, seq);
+  }
+
+  size_t Expire(TimePoint now = time::system_clock::now()) {
+    return store_->Expire(now);
+  }
+
+  const std::shared_ptr<const Data>& Find(NodeID nid, uint64_t seq) const {
+    return store_->Find(base_ + nid, seq);
+  }
+
+  bool Has(NodeID nid, uint64_t seq) const {
+    return store_->Has(base_ + nid, seq);
+  }
+
+  uint64_t RetentionHorizon(NodeID nid) const {
+    return store_->RetentionHorizon(base_ + nid);
+  }
+
+  size_t Size() const {
+    return store_->Size();
+  }
+
+  size_t Bytes() const {
+    return store_->Bytes();
+  }
+
+  size_t PeakBytes() const {
+    return store_->PeakBytes();
+  }
+
+  // objects dropped from the whole store; a group checks its retention
+  // horizons when this moves
+  size_t Evicted() const {
+    return store_->Evicted();
+  }
+
+ private:
+  std::shared_ptr<DataStore> store_;
+  NodeID base_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_DATA_STORE_HPP_
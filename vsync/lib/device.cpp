@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "device.hpp"
+
+#include <algorithm>
+
+#include "logging.hpp"
+#include "node.hpp"
+
+VSYNC_LOG_DEFINE(SyncForSleepDevice);
+
+namespace ndn {
+namespace vsync {
+
+// about a quarter of a sync slot; the slots of the groups of a device are
+// not aligned, so shorter gaps are common
+const time::milliseconds Device::kMinRadioSleep = time::milliseconds(1000);
+
+Device::Device(Face& face, Scheduler& scheduler, KeyChain& key_chain, size_t max_bytes,
+               time::milliseconds max_age)
+    : face_(face),
+      scheduler_(scheduler),
+      key_chain_(key_chain),
+      store_(std::make_shared<DataStore>(0, max_bytes, max_age)),
+      next_base_(0),
+      radio_on_(true),
+      radio_wakeup_num_(0),
+      radio_wakeup_saved_num_(0),
+      radio_sleeping_time_(0) {
+  // the group ID follows the prefix, and the name of the notified packet
+  // follows /ndn/incomingData and /ndn/incomingInterest
+  for (const auto& prefix: {kSyncPrefix, kSyncDataPrefix, kSyncDataListPrefix, kSyncRepairPrefix,
+                            kSyncACKPrefix, kSyncVVPrefix, kIncomignSyncACKPrefix}) {
+    RegisterPrefix(prefix, prefix.size());
+  }
+  RegisterPrefix(kIncomingDataPrefix, kIncomingDataPrefix.size() + 1);
+  RegisterPrefix(kIncomingInterestPrefix, kIncomingInterestPrefix.size() + 1);
+}
+
+void Device::RegisterPrefix(const Name& prefix, size_t gid_index) {
+  face_.setInterestFilter(
+      prefix, [this, gid_index] (const InterestFilter&, const Interest& interest) {
+        Node* node = Find(interest.getName(), gid_index);
+        if (node != nullptr) node->OnInterest(interest);
+      },
+      [prefix] (const Name&, const std::string& reason) {
+        VSYNC_LOG_TRACE( "device: Failed to register " << prefix.toUri() << ": " << reason);
+        throw Node::Error("Failed to register " + prefix.toUri() + ": " + reason);
+      });
+}
+
+Node* Device::Find(const Name& n, size_t gid_index) const {
+  if (n.size() <= gid_index) return nullptr;
+  const auto& gid = n.get(gid_index);
+  for (const auto& group: groups_) {
+    if (group.gid == gid) return group.node;
+  }
+  return nullptr;
+}
+
+GroupDataStore Device::Join(Node* node, const name::Component& gid, size_t group_size) {
+  for (const auto& group: groups_) {
+    if (group.gid == gid) throw Node::Error("Device already in group " + gid.toUri());
+  }
+  groups_.push_back(Group{gid, node, true});
+  NodeID base = next_base_;
+  next_base_ += group_size;
+  return GroupDataStore(store_, base);
+}
+
+void Device::Leave(Node* node) {
+  groups_.erase(std::remove_if(groups_.begin(), groups_.end(), [node] (const Group& g) { return g.node == node; }),
+                groups_.end());
+}
+
+void Device::Sleep(Node* node) {
+  for (auto& group: groups_) {
+    if (group.node == node) group.awake = false;
+  }
+  time::milliseconds next_wakeup = time::milliseconds::max();
+  for (const auto& group: groups_) {
+    if (group.node == node) continue;
+    if (group.awake) return;
+    next_wakeup = std::min(next_wakeup, group.node->TimeToWakeup());
+  }
+  if (!radio_on_) return;
+  if (next_wakeup < kMinRadioSleep) {
+    radio_wakeup_saved_num_++;
+    VSYNC_LOG_TRACE( "device: keep the radio on, next wake-up in " << next_wakeup.count() << " ms");
+    return;
+  }
+  SendRadioCommand(kLocalhostSleepingCommand);
+  radio_on_ = false;
+  radio_sleep_start_ = time::system_clock::now();
+}
+
+void Device::Wakeup(Node* node) {
+  for (auto& group: groups_) {
+    if (group.node == node) group.awake = true;
+  }
+  if (radio_on_) return;
+  SendRadioCommand(kLocalhostWakeupCommand);
+  radio_on_ = true;
+  radio_wakeup_num_++;
+  radio_sleeping_time_ += time::toUnixTimestamp(time::system_clock::now()).count() -
+                          time::toUnixTimestamp(radio_sleep_start_).count();
+}
+
+void Device::SendRadioCommand(const Name& command) {
+  Interest i(command);
+  face_.expressInterest(i, [](const Interest&, const Data&) {},
+                        [](const Interest&, const lp::Nack&) {},
+                        [](const Interest&) {});
+}
+
+}  // namespace vsync
+}  // namespace ndn
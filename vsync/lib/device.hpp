@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_DEVICE_HPP_
+#define NDN_VSYNC_DEVICE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "ndn-common.hpp"
+#include "vsync-common.hpp"
+#include "data-store.hpp"
+
+namespace ndn {
+namespace vsync {
+
+class Node;
+
+/**
+ * @brief A device in several groups.
+ *
+ * The Nodes of the groups, one per group, keep their own version vectors,
+ * receive windows and timers, but share
+ *  - one face, with one registration per prefix: interests are dispatched
+ *    to the Node of the group they name;
+ *  - one data store, with one byte budget and one expiry queue
+ *    (see GroupDataStore);
+ *  - the radio, which sleeps only when no group is awake. When the last
+ *    group goes to sleep and another one wakes up within kMinRadioSleep, the
+ *    radio stays on through the gap, since waking it up costs more than
+ *    idling for that long.
+ *
+ * Nodes join the device when they are constructed on it and leave it when
+ * they are destroyed; the device must outlive them.
+ */
+class Device {
+ public:
+  static const time::milliseconds kMinRadioSleep;
+
+  /**
+   * @param max_bytes  Byte budget of the shared data store, 0 for none
+   * @param max_age    Upper bound on the lifetime of an object, 0 for none
+   */
+  Device(Face& face, Scheduler& scheduler, KeyChain& key_chain, size_t max_bytes = 0,
+         time::milliseconds max_age = time::milliseconds(0));
+
+  Face& GetFace() { return face_; }
+  Scheduler& GetScheduler() { return scheduler_; }
+  KeyChain& GetKeyChain() { return key_chain_; }
+
+  size_t GroupNum() const { return groups_.size(); }
+  const DataStore& GetStore() const { return *store_; }
+
+  // the Node of the group named by component @p gid_index of @p n, if any
+  Node* Find(const Name& n, size_t gid_index) const;
+
+  // called by the Node of a group when it goes to sleep and wakes up; the
+  // radio follows the groups as described above
+  void Sleep(Node* node);
+  void Wakeup(Node* node);
+
+  bool IsRadioOn() const { return radio_on_; }
+
+  // radio wake-ups, and the wake-ups saved by keeping the radio on
+  uint64_t GetRadioWakeupNum() const { return radio_wakeup_num_; }
+  uint64_t GetRadioWakeupSavedNum() const { return radio_wakeup_saved_num_; }
+
+  // milliseconds the radio slept
+  uint64_t GetRadioSleepingTime() const { return radio_sleeping_time_; }
+
+ private:
+  friend class Node;
+
+  // adds the group of @p node, which starts awake; throws if the device is
+  // already in @p gid
+  GroupDataStore Join(Node* node, const name::Component& gid, size_t group_size);
+  void Leave(Node* node);
+
+  void RegisterPrefix(const Name& prefix, size_t gid_index);
+  void SendRadioCommand(const Name& command);
+
+ private:
+  struct Group {
+    name::Component gid;
+    Node* node;
+    bool awake;
+  };
+
+  Face& face_;
+  Scheduler& scheduler_;
+  KeyChain& key_chain_;
+  std::vector<Group> groups_;  // a handful, so searched linearly
+  std::shared_ptr<DataStore> store_;
+  NodeID next_base_;  // first producer of the store not given to a group yet
+  bool radio_on_;
+  time::system_clock::time_point radio_sleep_start_;
+  uint64_t radio_wakeup_num_;
+  uint64_t radio_wakeup_saved_num_;
+  uint64_t radio_sleeping_time_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_DEVICE_HPP_
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_FETCH_ORDER_HPP_
+#define NDN_VSYNC_FETCH_ORDER_HPP_
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * @brief Order in which a sync-responder fetches its missing data.
+ *
+ * All woken responders that fetch in producer order ask for the same names
+ * at the same time. The other policies spread their requests over different
+ * data, so that one broadcast reply is useful to more of them.
+ */
+enum FetchOrder : uint32_t {
+  kProducerOrder = 0,  // by producer, then by sequence number
+  kNewestFirst = 1,    // the gaps closest to the head of their producer first
+  kRandomOrder = 2,    // a random order drawn by each node
+  kRarestFirst = 3,    // the data held by the fewest active neighbours first
+};
+
+// objects [lo, hi] of producer nid that are missing
+struct FetchGap {
+  NodeID nid;
+  uint64_t lo;
+  uint64_t hi;
+};
+
+/**
+ * @brief Reorders @p gaps, which come in producer order, by @p order.
+ *
+ * @param head        our version vector, the head of every producer
+ * @param neighbours  version vectors recently heard from the active
+ *                    neighbours; for kRarestFirst, object s of producer p is
+ *                    assumed to be held by every neighbour v with v[p] >= s.
+ *                    Gaps are split where that count changes.
+ * @param rengine     random engine of the node, for kRandomOrder
+ */
+inline void OrderFetchGaps(FetchOrder order, std::vector<FetchGap>& gaps, const VersionVector& head,
+                           const std::vector<VersionVector>& neighbours, std::mt19937& rengine) {
+  switch (order) {
+    case kProducerOrder:
+      break;
+    case kNewestFirst:
+      std::stable_sort(gaps.begin(), gaps.end(), [&head] (const FetchGap& l, const FetchGap& r) {
+        return head[l.nid] - l.hi < head[r.nid] - r.hi;
+      });
+      break;
+    case kRandomOrder:
+      std::shuffle(gaps.begin(), gaps.end(), rengine);
+      break;
+    case kRarestFirst: {
+      std::vector<std::pair<size_t, FetchGap>> pieces;
+      std::vector<uint64_t> bounds;
+      for (const auto& gap: gaps) {
+        // a neighbour holds the objects up to its entry for the producer
+        bounds.clear();
+        for (const auto& vv: neighbours) {
+          if (gap.nid < vv.size() && vv[gap.nid] >= gap.lo && vv[gap.nid] < gap.hi) bounds.push_back(vv[gap.nid]);
+        }
+        bounds.push_back(gap.hi);
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+        uint64_t lo = gap.lo;
+        for (uint64_t hi: bounds) {
+          size_t holders = 0;
+          for (const auto& vv: neighbours) {
+            if (gap.nid < vv.size() && vv[gap.nid] >= hi) holders++;
+          }
+          pieces.emplace_back(holders, FetchGap{gap.nid, lo, hi});
+          lo = hi + 1;
+        }
+      }
+      std::stable_sort(pieces.begin(), pieces.end(),
+                       [] (const std::pair<size_t, FetchGap>& l, const std::pair<size_t, FetchGap>& r) {
+                         return l.first < r.first;
+                       });
+      gaps.clear();
+      for (const auto& piece: pieces) gaps.push_back(piece.second);
+      break;
+    }
+  }
+}
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_FETCH_ORDER_HPP_
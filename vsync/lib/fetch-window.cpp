@@ -0,0 +1,35 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "fetch-window.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace vsync {
+
+const double FetchWindow::kMin = 1.0;
+const double FetchWindow::kMax = 16.0;
+const double FetchWindow::kInit = 2.0;
+
+FetchWindow::FetchWindow()
+    : window_(kInit),
+      peak_(kInit),
+      serial_(0),
+      decrease_serial_(0) {
+}
+
+void FetchWindow::OnReply(bool contended) {
+  if (contended) return;
+  window_ = std::min(kMax, window_ + 1 / window_);
+  peak_ = std::max(peak_, window_);
+}
+
+bool FetchWindow::OnTimeout(uint64_t serial) {
+  if (serial < decrease_serial_) return false;
+  window_ = std::max(kMin, window_ / 2);
+  decrease_serial_ = serial_;
+  return true;
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_FETCH_WINDOW_HPP_
+#define NDN_VSYNC_FETCH_WINDOW_HPP_
+
+#include <cstdint>
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Number of data interests a node keeps in flight while fetching.
+ *
+ * Every fetch sent takes a serial. A reply grows the window by 1 / window,
+ * about one interest per window of replies, unless other nodes were heard
+ * fetching the same data since the last adjustment. A timeout halves the
+ * window, down to kMin, once per loss event: the fetches sent before the
+ * last decrease were in flight when it happened, so their timeouts belong to
+ * the same event and leave the window as it is.
+ */
+class FetchWindow {
+ public:
+  static const double kMin;
+  static const double kMax;
+  static const double kInit;
+
+  FetchWindow();
+
+  // serial of the fetch being sent
+  uint64_t OnSend() { return serial_++; }
+
+  // @p contended: other nodes fetched the same data since the last adjustment
+  void OnReply(bool contended);
+
+  // @return whether the timeout of fetch @p serial halved the window
+  bool OnTimeout(uint64_t serial);
+
+  double Size() const { return window_; }
+  double Peak() const { return peak_; }
+
+ private:
+  double window_;
+  double peak_;
+  uint64_t serial_;           // serial of the next fetch
+  uint64_t decrease_serial_;  // fetches sent before the last decrease
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_FETCH_WINDOW_HPP_
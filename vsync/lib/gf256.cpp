@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "gf256.hpp"
+
+#include <cstring>
+
+#include "vv-kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VSYNC_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ndn {
+namespace vsync {
+namespace gf256 {
+
+namespace {
+
+// log/exp tables of the generator 2; exp is doubled so that the sum of two
+// logs never needs a modulo
+struct Tables {
+  uint8_t exp[512];
+  uint8_t log[256];
+
+  Tables() {
+    unsigned x = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp[i] = static_cast<uint8_t>(x);
+      log[x] = static_cast<uint8_t>(i);
+      x <<= 1;
+      if (x & 0x100) x ^= 0x11d;
+    }
+    for (int i = 255; i < 512; ++i) exp[i] = exp[i - 255];
+    log[0] = 0;
+  }
+};
+
+const Tables& GetTables() {
+  static const Tables tables;
+  return tables;
+}
+
+// the products c * x for every byte x
+void MulRow(uint8_t c, uint8_t row[256]) {
+  const Tables& t = GetTables();
+  row[0] = 0;
+  if (c == 0) {
+    std::memset(row, 0, 256);
+    return;
+  }
+  for (int x = 1; x < 256; ++x) row[x] = t.exp[t.log[c] + t.log[x]];
+}
+
+}  // namespace
+
+uint8_t Mul(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) return 0;
+  const Tables& t = GetTables();
+  return t.exp[t.log[a] + t.log[b]];
+}
+
+uint8_t Inv(uint8_t a) {
+  const Tables& t = GetTables();
+  return t.exp[255 - t.log[a]];
+}
+
+void MulAddScalar(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n) {
+  if (c == 0) return;
+  if (c == 1) {
+    for (size_t i = 0; i < n; ++i) dst[i] ^= src[i];
+    return;
+  }
+  uint8_t row[256];
+  MulRow(c, row);
+  for (size_t i = 0; i < n; ++i) dst[i] ^= row[src[i]];
+}
+
+void MulScalar(uint8_t* dst, uint8_t c, size_t n) {
+  if (c == 1) return;
+  uint8_t row[256];
+  MulRow(c, row);
+  for (size_t i = 0; i < n; ++i) dst[i] = row[dst[i]];
+}
+
+#ifdef VSYNC_HAVE_X86
+
+// c * x = c * (x & 0x0f) ^ c * (x & 0xf0), and each half is looked up in a
+// 16-entry table with _mm256_shuffle_epi8.
+
+__attribute__((target("avx2")))
+static inline void LoadNibbleTables(uint8_t c, __m256i& lo, __m256i& hi) {
+  alignas(16) uint8_t lo_table[16];
+  alignas(16) uint8_t hi_table[16];
+  for (int x = 0; x < 16; ++x) {
+    lo_table[x] = Mul(c, static_cast<uint8_t>(x));
+    hi_table[x] = Mul(c, static_cast<uint8_t>(x << 4));
+  }
+  lo = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(lo_table)));
+  hi = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(hi_table)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i Mul32(__m256i x, __m256i lo, __m256i hi, __m256i mask) {
+  __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask));
+  __m256i h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask));
+  return _mm256_xor_si256(l, h);
+}
+
+__attribute__((target("avx2")))
+void MulAddAVX2(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n) {
+  if (c == 0) return;
+  __m256i lo, hi;
+  LoadNibbleTables(c, lo, hi);
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(d, Mul32(s, lo, hi, mask)));
+  }
+  MulAddScalar(dst + i, src + i, c, n - i);
+}
+
+__attribute__((target("avx2")))
+void MulAVX2(uint8_t* dst, uint8_t c, size_t n) {
+  if (c == 1) return;
+  __m256i lo, hi;
+  LoadNibbleTables(c, lo, hi);
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Mul32(d, lo, hi, mask));
+  }
+  MulScalar(dst + i, c, n - i);
+}
+
+#else
+
+void MulAddAVX2(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n) {
+  MulAddScalar(dst, src, c, n);
+}
+
+void MulAVX2(uint8_t* dst, uint8_t c, size_t n) {
+  MulScalar(dst, c, n);
+}
+
+#endif  // VSYNC_HAVE_X86
+
+bool HasAVX2() {
+  return vv_kernels::HasAVX2();
+}
+
+MulAddFn GetMulAdd() {
+  static const MulAddFn mul_add = HasAVX2() ? MulAddAVX2 : MulAddScalar;
+  return mul_add;
+}
+
+MulFn GetMul() {
+  static const MulFn mul = HasAVX2() ? MulAVX2 : MulScalar;
+  return mul;
+}
+
+}  // namespace gf256
+}  // namespace vsync
+}  // namespace ndn
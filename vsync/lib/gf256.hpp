@@ -0,0 +1,46 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_GF256_HPP_
+#define NDN_VSYNC_GF256_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ndn {
+namespace vsync {
+
+// Arithmetic over GF(2^8) with the polynomial x^8 + x^4 + x^3 + x^2 + 1
+// (0x11d), for network-coded repair. Addition is XOR. The region kernels
+// have a portable table-driven version and an AVX2 version that multiplies
+// 32 bytes at a time with two 16-entry nibble tables; the Get* functions
+// pick the AVX2 one at runtime when the CPU supports it.
+namespace gf256 {
+
+uint8_t Mul(uint8_t a, uint8_t b);
+
+// multiplicative inverse; @p a must not be 0
+uint8_t Inv(uint8_t a);
+
+// dst[i] ^= c * src[i]
+using MulAddFn = void (*)(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n);
+// dst[i] = c * dst[i]
+using MulFn = void (*)(uint8_t* dst, uint8_t c, size_t n);
+
+void MulAddScalar(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n);
+void MulScalar(uint8_t* dst, uint8_t c, size_t n);
+
+// Only call these when HasAVX2() returns true.
+void MulAddAVX2(uint8_t* dst, const uint8_t* src, uint8_t c, size_t n);
+void MulAVX2(uint8_t* dst, uint8_t c, size_t n);
+
+bool HasAVX2();
+
+// Kernels selected for this CPU
+MulAddFn GetMulAdd();
+MulFn GetMul();
+
+}  // namespace gf256
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_GF256_HPP_
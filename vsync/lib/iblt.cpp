@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "iblt.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "vsync-helper.hpp"
+
+namespace ndn {
+namespace vsync {
+
+// the largest table we accept from the network
+static const size_t kMaxCells = 1 << 16;
+
+static inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+static inline uint64_t ItemHash(NodeID nid, uint64_t seq, uint64_t seed) {
+  return Mix64(Mix64(nid + seed * 0x9e3779b97f4a7c15ULL) ^ seq);
+}
+
+static inline uint64_t ZigZag(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+static inline int64_t UnZigZag(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+static void AppendVarint(uint64_t value, std::string& out) {
+  uint8_t buf[kMaxVarintSize];
+  out.append(reinterpret_cast<const char*>(buf), EncodeVarint(value, buf));
+}
+
+static void AppendFixed(uint64_t value, size_t bytes, std::string& out) {
+  for (size_t i = 0; i < bytes; ++i) out.push_back(static_cast<char>(value >> (8 * i)));
+}
+
+static const uint8_t* DecodeFixed(const uint8_t* begin, const uint8_t* end, size_t bytes, uint64_t& value) {
+  if (begin == nullptr || static_cast<size_t>(end - begin) < bytes) return nullptr;
+  value = 0;
+  for (size_t i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(begin[i]) << (8 * i);
+  return begin + bytes;
+}
+
+/****************************************************************/
+/* IBLT                                                         */
+/****************************************************************/
+const size_t IBLT::kHashNum;
+
+size_t IBLT::CellsFor(size_t difference) {
+  // empty cells take one byte on the wire, so leave plenty of room: two
+  // items sharing all their cells, the usual failure of small tables, get
+  // rare quickly with more cells
+  return difference * 4 + 4 * kHashNum;
+}
+
+IBLT::IBLT(size_t cells)
+    : cells_((std::max(cells, kHashNum) + kHashNum - 1) / kHashNum * kHashNum) {
+}
+
+void IBLT::Update(const SetItem& item, int64_t count) {
+  size_t part = cells_.size() / kHashNum;
+  uint32_t check = static_cast<uint32_t>(ItemHash(item.nid, item.seq, 0));
+  for (size_t j = 0; j < kHashNum; ++j) {
+    Cell& cell = cells_[j * part + ItemHash(item.nid, item.seq, j + 1) % part];
+    cell.count += count;
+    cell.nid_sum ^= item.nid;
+    cell.seq_sum ^= item.seq;
+    cell.check_sum ^= check;
+  }
+}
+
+bool IBLT::Pure(const Cell& cell) {
+  return (cell.count == 1 || cell.count == -1) && cell.nid_sum <= std::numeric_limits<NodeID>::max() &&
+         cell.check_sum == static_cast<uint32_t>(ItemHash(static_cast<NodeID>(cell.nid_sum), cell.seq_sum, 0));
+}
+
+bool IBLT::Subtract(const IBLT& other) {
+  if (other.cells_.size() != cells_.size()) return false;
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    cells_[i].count -= other.cells_[i].count;
+    cells_[i].nid_sum ^= other.cells_[i].nid_sum;
+    cells_[i].seq_sum ^= other.cells_[i].seq_sum;
+    cells_[i].check_sum ^= other.cells_[i].check_sum;
+  }
+  return true;
+}
+
+bool IBLT::List(std::vector<SetItem>& left, std::vector<SetItem>& right) const {
+  left.clear();
+  right.clear();
+  IBLT peeled(*this);
+  std::vector<size_t> pure;
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    if (Pure(cells_[i])) pure.push_back(i);
+  }
+  // removing a listed item can make the other cells it is in pure
+  while (!pure.empty()) {
+    size_t i = pure.back();
+    pure.pop_back();
+    const Cell& cell = peeled.cells_[i];
+    if (!Pure(cell)) continue;
+    SetItem item{static_cast<NodeID>(cell.nid_sum), cell.seq_sum};
+    int64_t count = cell.count;
+    (count > 0 ? left : right).push_back(item);
+    // a difference cannot have more items than cells with them
+    if (left.size() + right.size() > cells_.size() * kHashNum) return false;
+    peeled.Update(item, -count);
+    size_t part = cells_.size() / kHashNum;
+    for (size_t j = 0; j < kHashNum; ++j) {
+      size_t k = j * part + ItemHash(item.nid, item.seq, j + 1) % part;
+      if (Pure(peeled.cells_[k])) pure.push_back(k);
+    }
+  }
+  return std::all_of(peeled.cells_.begin(), peeled.cells_.end(), [] (const Cell& c) { return c.Empty(); });
+}
+
+// varint(cells), then per cell varint(zigzag(count) << 1 | non-empty) and,
+// for non-empty cells, varint(nid_sum) varint(seq_sum) and 4 check bytes
+void IBLT::Encode(std::string& out) const {
+  AppendVarint(cells_.size(), out);
+  for (const auto& cell: cells_) {
+    bool empty = cell.Empty();
+    AppendVarint(ZigZag(cell.count) << 1 | (empty ? 0 : 1), out);
+    if (empty) continue;
+    AppendVarint(cell.nid_sum, out);
+    AppendVarint(cell.seq_sum, out);
+    AppendFixed(cell.check_sum, 4, out);
+  }
+}
+
+bool IBLT::Decode(const uint8_t* buf, size_t buf_size) {
+  const uint8_t* end = buf + buf_size;
+  uint64_t num = 0;
+  buf = DecodeVarint(buf, end, num);
+  if (buf == nullptr || num == 0 || num > kMaxCells || num % kHashNum != 0) return false;
+  cells_.assign(num, Cell());
+  for (auto& cell: cells_) {
+    uint64_t header = 0, check = 0;
+    buf = DecodeVarint(buf, end, header);
+    if (buf == nullptr) return false;
+    cell.count = UnZigZag(header >> 1);
+    if ((header & 1) == 0) continue;
+    buf = DecodeVarint(buf, end, cell.nid_sum);
+    if (buf == nullptr) return false;
+    buf = DecodeVarint(buf, end, cell.seq_sum);
+    buf = DecodeFixed(buf, end, 4, check);
+    if (buf == nullptr) return false;
+    cell.check_sum = static_cast<uint32_t>(check);
+  }
+  return buf == end;
+}
+
+/****************************************************************/
+/* strata estimator                                             */
+/****************************************************************/
+static const size_t kStrataHashNum = 3;
+
+const size_t StrataEstimator::kStrata;
+const size_t StrataEstimator::kCellsPerStratum;
+
+StrataEstimator::StrataEstimator()
+    : cells_(kStrata * kCellsPerStratum) {
+  static_assert(kCellsPerStratum % kStrataHashNum == 0, "strata are split in equal parts");
+}
+
+static inline uint8_t KeyCheck(uint16_t key) {
+  return static_cast<uint8_t>(Mix64(key));
+}
+
+static inline size_t KeyCell(uint16_t key, size_t j) {
+  size_t part = StrataEstimator::kCellsPerStratum / kStrataHashNum;
+  return j * part + Mix64(static_cast<uint64_t>(key) + (j + 1) * 0x9e3779b97f4a7c15ULL) % part;
+}
+
+void StrataEstimator::Insert(const SetItem& item) {
+  uint64_t h = ItemHash(item.nid, item.seq, 7);
+  size_t stratum = 0;
+  while (stratum + 1 < kStrata && (h & 1) == 0) {
+    h >>= 1;
+    stratum++;
+  }
+  uint16_t key = static_cast<uint16_t>(ItemHash(item.nid, item.seq, 8));
+  Cell* stratum_cells = &cells_[stratum * kCellsPerStratum];
+  for (size_t j = 0; j < kStrataHashNum; ++j) {
+    Cell& cell = stratum_cells[KeyCell(key, j)];
+    cell.count++;
+    cell.key_sum ^= key;
+    cell.check_sum ^= KeyCheck(key);
+  }
+}
+
+size_t StrataEstimator::Estimate(const StrataEstimator& other) const {
+  size_t count = 0;
+  for (size_t s = kStrata; s-- > 0;) {
+    std::vector<Cell> diff(cells_.begin() + s * kCellsPerStratum, cells_.begin() + (s + 1) * kCellsPerStratum);
+    for (size_t i = 0; i < kCellsPerStratum; ++i) {
+      const Cell& o = other.cells_[s * kCellsPerStratum + i];
+      diff[i].count -= o.count;
+      diff[i].key_sum ^= o.key_sum;
+      diff[i].check_sum ^= o.check_sum;
+    }
+    auto pure = [] (const Cell& c) {
+      return (c.count == 1 || c.count == 0xff) && c.check_sum == KeyCheck(c.key_sum);
+    };
+    bool progress = true;
+    size_t listed = 0;
+    while (progress && listed <= kCellsPerStratum * kStrataHashNum) {
+      progress = false;
+      for (size_t i = 0; i < kCellsPerStratum; ++i) {
+        if (!pure(diff[i])) continue;
+        uint16_t key = diff[i].key_sum;
+        uint8_t c = diff[i].count;
+        for (size_t j = 0; j < kStrataHashNum; ++j) {
+          Cell& cell = diff[KeyCell(key, j)];
+          cell.count -= c;
+          cell.key_sum ^= key;
+          cell.check_sum ^= KeyCheck(key);
+        }
+        listed++;
+        progress = true;
+      }
+    }
+    bool empty = std::all_of(diff.begin(), diff.end(), [] (const Cell& c) { return c.Empty(); });
+    // stratum s holds about 1/2^(s+1) of the items
+    if (!empty) return std::max<size_t>(count, 1) << (s + 1);
+    count += listed;
+  }
+  return count;
+}
+
+// a bitmap of the non-empty cells, then 4 bytes (count, key, check) for each
+// of them
+void StrataEstimator::Encode(std::string& out) const {
+  size_t bitmap = out.size();
+  out.append((cells_.size() + 7) / 8, 0);
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    const Cell& cell = cells_[i];
+    if (cell.Empty()) continue;
+    out[bitmap + i / 8] |= static_cast<char>(1 << (i % 8));
+    AppendFixed(cell.count, 1, out);
+    AppendFixed(cell.key_sum, 2, out);
+    AppendFixed(cell.check_sum, 1, out);
+  }
+}
+
+bool StrataEstimator::Decode(const uint8_t* buf, size_t buf_size) {
+  const uint8_t* end = buf + buf_size;
+  size_t bitmap_size = (cells_.size() + 7) / 8;
+  if (buf_size < bitmap_size) return false;
+  const uint8_t* bitmap = buf;
+  buf += bitmap_size;
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    Cell& cell = cells_[i];
+    cell = Cell();
+    if ((bitmap[i / 8] & (1 << (i % 8))) == 0) continue;
+    uint64_t value = 0;
+    buf = DecodeFixed(buf, end, 4, value);
+    if (buf == nullptr) return false;
+    cell.count = static_cast<uint8_t>(value);
+    cell.key_sum = static_cast<uint16_t>(value >> 8);
+    cell.check_sum = static_cast<uint8_t>(value >> 24);
+  }
+  return buf == end;
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_IBLT_HPP_
+#define NDN_VSYNC_IBLT_HPP_
+
+#include <string>
+#include <vector>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Set reconciliation of version vectors.
+ *
+ * A version vector v is seen as the set of items (i, v[i]) for v[i] > 0.
+ * Two vectors differ in two items per entry that changed, so an invertible
+ * Bloom lookup table (IBLT) of the difference is as large as the number of
+ * changed entries, whatever the size of the group. The size of the table is
+ * picked from a strata estimator of the difference, which grows only with
+ * the logarithm of the group size.
+ */
+
+struct SetItem {
+  NodeID nid;
+  uint64_t seq;
+};
+
+// the items of a version vector
+inline std::vector<SetItem> VVItems(const VersionVector& vv) {
+  std::vector<SetItem> items;
+  for (size_t i = 0; i < vv.size(); ++i) {
+    if (vv[i] != 0) items.push_back(SetItem{static_cast<NodeID>(i), vv[i]});
+  }
+  return items;
+}
+
+class IBLT {
+ public:
+  // every item goes into one cell of each of the kHashNum equal parts
+  static const size_t kHashNum = 3;
+
+  // a table for about @p difference items of symmetric difference
+  static size_t CellsFor(size_t difference);
+
+  // @p cells is rounded up to a multiple of kHashNum
+  explicit IBLT(size_t cells = kHashNum);
+
+  size_t Cells() const { return cells_.size(); }
+
+  void Insert(const SetItem& item) { Update(item, 1); }
+  void Erase(const SetItem& item) { Update(item, -1); }
+
+  // leaves the difference this - @p other; both must have the same size
+  bool Subtract(const IBLT& other);
+
+  /**
+   * @brief Lists the items of the difference: @p left are the items only in
+   *        the minuend, @p right the ones only in the subtrahend.
+   *
+   * @return false if the table holds more than it can list; the lists are
+   *         then incomplete
+   */
+  bool List(std::vector<SetItem>& left, std::vector<SetItem>& right) const;
+
+  void Encode(std::string& out) const;
+  // false if @p buf is malformed
+  bool Decode(const uint8_t* buf, size_t buf_size);
+
+ private:
+  struct Cell {
+    int64_t count = 0;
+    uint64_t nid_sum = 0;
+    uint64_t seq_sum = 0;
+    uint32_t check_sum = 0;
+
+    bool Empty() const { return count == 0 && nid_sum == 0 && seq_sum == 0 && check_sum == 0; }
+  };
+
+  void Update(const SetItem& item, int64_t count);
+  static bool Pure(const Cell& cell);
+
+ private:
+  std::vector<Cell> cells_;
+};
+
+/**
+ * @brief Strata estimator of the size of a set difference.
+ *
+ * Items are spread over kStrata strata by the number of trailing zeros of
+ * their hash, so stratum s holds about 1/2^(s+1) of them, and each stratum is
+ * a tiny IBLT of kCellsPerStratum cells over 16-bit item hashes. The
+ * difference is counted exactly in the strata that can be listed, from the
+ * sparsest down, and extrapolated from the first one that cannot. Cells are
+ * 4 bytes and empty ones are left out, so that the estimator stays well
+ * below the size of the version vectors of a large group.
+ */
+class StrataEstimator {
+ public:
+  static const size_t kStrata = 12;
+  static const size_t kCellsPerStratum = 6;
+
+  StrataEstimator();
+
+  void Insert(const SetItem& item);
+
+  // estimated size of the symmetric difference with @p other
+  size_t Estimate(const StrataEstimator& other) const;
+
+  void Encode(std::string& out) const;
+  bool Decode(const uint8_t* buf, size_t buf_size);
+
+ private:
+  // counts wrap around; a cell is pure when it counts +1 or -1 and its
+  // check matches its key
+  struct Cell {
+    uint8_t count = 0;
+    uint16_t key_sum = 0;
+    uint8_t check_sum = 0;
+
+    bool Empty() const { return count == 0 && key_sum == 0 && check_sum == 0; }
+  };
+
+ private:
+  std::vector<Cell> cells_;  // kStrata x kCellsPerStratum
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_IBLT_HPP_
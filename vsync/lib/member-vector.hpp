@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_MEMBER_VECTOR_HPP_
+#define NDN_VSYNC_MEMBER_VECTOR_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * @brief Vector with one entry per group member.
+ *
+ * The first @p N entries are stored inline, so for groups of up to @p N
+ * members the per-member state of a node (and every copy of it, such as the
+ * snapshots) needs no heap allocation. Larger groups spill to a std::vector
+ * once and stay there, so clearing and refilling a spilled vector does not
+ * allocate either.
+ *
+ * Unused slots hold default-constructed values (unless @p T is trivially
+ * destructible, where clearing leaves them as they are), which is why @p T
+ * must be default-constructible.
+ */
+template <typename T, size_t N>
+class MemberVector {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  MemberVector() { Init(); }
+
+  explicit MemberVector(size_t n, const T& value = T()) {
+    Init();
+    assign(n, value);
+  }
+
+  MemberVector(std::initializer_list<T> init) {
+    Init();
+    reserve(init.size());
+    for (const auto& v: init) push_back(v);
+  }
+
+  template <typename InputIt,
+            typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+  MemberVector(InputIt first, InputIt last) {
+    Init();
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  // copies only the live entries: a copy of a spilled vector allocates
+  // exactly its size and does not touch the inline slots
+  MemberVector(const MemberVector& other) {
+    Init();
+    CopyFrom(other);
+  }
+
+  MemberVector& operator=(const MemberVector& other) {
+    if (this != &other) CopyFrom(other);
+    return *this;
+  }
+
+  // the source is left empty and inline, like a default-constructed vector
+  MemberVector(MemberVector&& other) {
+    Init();
+    MoveFrom(other);
+  }
+
+  MemberVector& operator=(MemberVector&& other) {
+    if (this == &other) return *this;
+    Reset();
+    MoveFrom(other);
+    return *this;
+  }
+
+  static constexpr size_t inline_capacity() { return N; }
+
+  size_t size() const { return end_ - data_; }
+  bool empty() const { return end_ == data_; }
+  size_t capacity() const { return limit_ - data_; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  iterator begin() { return data_; }
+  iterator end() { return end_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return end_; }
+
+  T& operator[](size_t i) { return data_[i]; }
+  const T& operator[](size_t i) const { return data_[i]; }
+  T& front() { return data_[0]; }
+  const T& front() const { return data_[0]; }
+  T& back() { return end_[-1]; }
+  const T& back() const { return end_[-1]; }
+
+  void reserve(size_t n) {
+    if (n > capacity()) Grow(n);
+  }
+
+  void push_back(const T& value) {
+    if (end_ == limit_) Grow(0);
+    *end_++ = value;
+  }
+
+  void pop_back() {
+    --end_;
+    Release(end_, end_ + 1);
+  }
+
+  void clear() {
+    Release(data_, end_);
+    end_ = data_;
+  }
+
+  void resize(size_t n, const T& value = T()) {
+    if (n > capacity()) Grow(n);
+    if (data_ + n < end_) Release(data_ + n, end_);
+    else std::fill(end_, data_ + n, value);
+    end_ = data_ + n;
+  }
+
+  void assign(size_t n, const T& value) {
+    clear();
+    resize(n, value);
+  }
+
+  bool operator==(const MemberVector& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const MemberVector& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  bool OnHeap() const { return data_ != inline_.data(); }
+
+  // unused slots give up what they hold; a no-op for trivial types
+  static void Release(T* first, T* last) {
+    if (!std::is_trivially_destructible<T>::value) std::fill(first, last, T());
+  }
+
+  // growing and copying are kept out of line, so that the loops that copy
+  // and refill member vectors stay small enough to be inlined themselves
+
+  // move the entries to a heap buffer of exactly @p n slots, or of twice
+  // the capacity for @p n == 0
+  __attribute__((noinline)) void Grow(size_t n) {
+    if (n == 0) n = 2 * capacity();
+    std::vector<T> grown(n);
+    auto grown_end = std::move(data_, end_, grown.begin());
+    if (!OnHeap()) Release(data_, end_);
+    heap_.swap(grown);
+    data_ = heap_.data();
+    end_ = data_ + (grown_end - heap_.begin());
+    limit_ = data_ + n;
+  }
+
+  // a spilled vector stays spilled, reusing its buffer when it is large
+  // enough
+  __attribute__((noinline)) void CopyFrom(const MemberVector& other) {
+    size_t n = other.size();
+    if (n > capacity()) {
+      if (!OnHeap()) Release(data_, end_);
+      heap_.assign(other.begin(), other.end());
+      data_ = heap_.data();
+      limit_ = data_ + n;
+    } else {
+      std::copy(other.begin(), other.end(), data_);
+      if (data_ + n < end_) Release(data_ + n, end_);
+    }
+    end_ = data_ + n;
+  }
+
+  // steals the heap buffer of @p other, or moves its inline entries
+  void MoveFrom(MemberVector& other) {
+    if (other.OnHeap()) {
+      heap_ = std::move(other.heap_);
+      data_ = other.data_;
+      end_ = other.end_;
+      limit_ = other.limit_;
+    } else {
+      end_ = std::move(other.begin(), other.end(), inline_.begin());
+    }
+    other.Reset();
+  }
+
+  void Init() {
+    data_ = end_ = inline_.data();
+    limit_ = data_ + N;
+  }
+
+  // back to the state of a default-constructed vector
+  void Reset() {
+    if (!OnHeap()) Release(data_, end_);
+    std::vector<T>().swap(heap_);
+    Init();
+  }
+
+  std::array<T, N> inline_;
+  std::vector<T> heap_;
+  // [data_, limit_) is inline_ until the vector spills, then all of heap_;
+  // the entries are [data_, end_)
+  T* data_;
+  T* end_;
+  T* limit_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_MEMBER_VECTOR_HPP_
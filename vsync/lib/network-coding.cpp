@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "network-coding.hpp"
+
+#include <algorithm>
+
+#include "gf256.hpp"
+#include "vsync-helper.hpp"
+
+namespace ndn {
+namespace vsync {
+
+static void AppendVarint(uint64_t value, std::string& out) {
+  uint8_t buf[kMaxVarintSize];
+  out.append(reinterpret_cast<const char*>(buf), EncodeVarint(value, buf));
+}
+
+void AppendRepairItems(const std::vector<RepairItem>& items, std::string& out) {
+  AppendVarint(items.size(), out);
+  for (const auto& item: items) {
+    AppendVarint(item.nid, out);
+    AppendVarint(item.seq, out);
+  }
+}
+
+const uint8_t* DecodeRepairItems(const uint8_t* begin, const uint8_t* end, std::vector<RepairItem>& items) {
+  uint64_t num = 0;
+  begin = DecodeVarint(begin, end, num);
+  // every item takes at least 2 bytes
+  if (begin == nullptr || num > static_cast<uint64_t>(end - begin) / 2) return nullptr;
+  items.clear();
+  items.reserve(num);
+  for (uint64_t i = 0; i < num; ++i) {
+    uint64_t nid = 0, seq = 0;
+    begin = DecodeVarint(begin, end, nid);
+    if (begin == nullptr) return nullptr;
+    begin = DecodeVarint(begin, end, seq);
+    if (begin == nullptr) return nullptr;
+    items.push_back(RepairItem{static_cast<NodeID>(nid), seq});
+  }
+  return begin;
+}
+
+// the source symbol of an object: its length and its wire encoding
+static void MakeSymbol(const uint8_t* wire, size_t size, std::string& symbol) {
+  symbol.resize(size + 2);
+  symbol[0] = static_cast<char>(size >> 8);
+  symbol[1] = static_cast<char>(size & 0xff);
+  std::copy(wire, wire + size, symbol.begin() + 2);
+}
+
+const size_t RepairEncoder::kMaxObjectSize;
+
+bool RepairEncoder::Contains(NodeID nid, uint64_t seq) const {
+  return std::find(items_.begin(), items_.end(), RepairItem{nid, seq}) != items_.end();
+}
+
+bool RepairEncoder::Add(NodeID nid, uint64_t seq, const uint8_t* wire, size_t size) {
+  if (size > kMaxObjectSize) return false;
+  items_.push_back(RepairItem{nid, seq});
+  symbols_.emplace_back();
+  MakeSymbol(wire, size, symbols_.back());
+  symbol_size_ = std::max(symbol_size_, symbols_.back().size());
+  return true;
+}
+
+std::string RepairEncoder::Encode(std::mt19937& rengine) const {
+  std::string packet;
+  AppendRepairItems(items_, packet);
+  AppendVarint(symbol_size_, packet);
+
+  std::uniform_int_distribution<int> rdist(0, 255);
+  std::vector<uint8_t> coeff(items_.size());
+  // an all-zero combination carries nothing
+  do {
+    for (auto& c: coeff) c = static_cast<uint8_t>(rdist(rengine));
+  } while (!items_.empty() && std::all_of(coeff.begin(), coeff.end(), [] (uint8_t c) { return c == 0; }));
+  packet.append(coeff.begin(), coeff.end());
+
+  // symbols shorter than symbol_size_ are zero-padded, which adds nothing
+  std::vector<uint8_t> payload(symbol_size_, 0);
+  auto mul_add = gf256::GetMulAdd();
+  for (size_t i = 0; i < items_.size(); ++i) {
+    mul_add(payload.data(), reinterpret_cast<const uint8_t*>(symbols_[i].data()), coeff[i], symbols_[i].size());
+  }
+  packet.append(payload.begin(), payload.end());
+  return packet;
+}
+
+bool RepairDecoder::Start(const std::vector<RepairItem>& items, size_t symbol_size) {
+  items_ = items;
+  symbol_size_ = symbol_size;
+  column_.assign(items_.size(), -1);
+  known_.assign(items_.size(), std::vector<uint8_t>());
+  unknown_.clear();
+  std::string wire, symbol;
+  for (size_t i = 0; i < items_.size(); ++i) {
+    if (lookup_ && lookup_(items_[i].nid, items_[i].seq, wire) && wire.size() + 2 <= symbol_size_) {
+      MakeSymbol(reinterpret_cast<const uint8_t*>(wire.data()), wire.size(), symbol);
+      known_[i].assign(symbol.begin(), symbol.end());
+      known_[i].resize(symbol_size_, 0);
+    } else {
+      column_[i] = static_cast<int>(unknown_.size());
+      unknown_.push_back(i);
+    }
+  }
+  started_ = true;
+  return true;
+}
+
+bool RepairDecoder::Add(const uint8_t* packet, size_t size) {
+  const uint8_t* end = packet + size;
+  std::vector<RepairItem> items;
+  const uint8_t* p = DecodeRepairItems(packet, end, items);
+  if (p == nullptr) return false;
+  uint64_t symbol_size = 0;
+  p = DecodeVarint(p, end, symbol_size);
+  if (p == nullptr || static_cast<uint64_t>(end - p) != items.size() + symbol_size) return false;
+
+  if (!started_) {
+    Start(items, symbol_size);
+  } else if (items != items_ || symbol_size != symbol_size_) {
+    return false;
+  }
+  if (Complete()) return false;
+
+  const uint8_t* coeff = p;
+  Row row;
+  row.coeff.assign(unknown_.size(), 0);
+  row.payload.assign(p + items_.size(), end);
+
+  // move the known objects out of the combination
+  auto mul_add = gf256::GetMulAdd();
+  for (size_t i = 0; i < items_.size(); ++i) {
+    if (column_[i] < 0) {
+      mul_add(row.payload.data(), known_[i].data(), coeff[i], symbol_size_);
+    } else {
+      row.coeff[column_[i]] = coeff[i];
+    }
+  }
+
+  // reduce by the rows we have; they are zero at each other's pivots
+  for (const auto& r: rows_) {
+    uint8_t c = row.coeff[r.pivot];
+    if (c == 0) continue;
+    mul_add(row.coeff.data(), r.coeff.data(), c, row.coeff.size());
+    mul_add(row.payload.data(), r.payload.data(), c, symbol_size_);
+  }
+  auto it = std::find_if(row.coeff.begin(), row.coeff.end(), [] (uint8_t c) { return c != 0; });
+  if (it == row.coeff.end()) return false;
+  row.pivot = it - row.coeff.begin();
+
+  auto mul = gf256::GetMul();
+  uint8_t inv = gf256::Inv(*it);
+  mul(row.coeff.data(), inv, row.coeff.size());
+  mul(row.payload.data(), inv, symbol_size_);
+
+  // and clear the new pivot from the others
+  for (auto& r: rows_) {
+    uint8_t c = r.coeff[row.pivot];
+    if (c == 0) continue;
+    mul_add(r.coeff.data(), row.coeff.data(), c, row.coeff.size());
+    mul_add(r.payload.data(), row.payload.data(), c, symbol_size_);
+  }
+  rows_.push_back(std::move(row));
+  return true;
+}
+
+void RepairDecoder::ForEachDecoded(
+    const std::function<void(NodeID nid, uint64_t seq, const uint8_t* wire, size_t size)>& f) const {
+  if (!Complete()) return;
+  // fully reduced: row r is the symbol of unknown object r.pivot
+  for (const auto& r: rows_) {
+    if (symbol_size_ < 2) continue;
+    size_t size = (static_cast<size_t>(r.payload[0]) << 8) | r.payload[1];
+    if (size + 2 > symbol_size_) continue;
+    const RepairItem& item = items_[unknown_[r.pivot]];
+    f(item.nid, item.seq, r.payload.data() + 2, size);
+  }
+}
+
+}  // namespace vsync
+}  // namespace ndn
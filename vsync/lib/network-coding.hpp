@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_NETWORK_CODING_HPP_
+#define NDN_VSYNC_NETWORK_CODING_HPP_
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Network-coded repair.
+ *
+ * After a sync, every woken responder asks the sync-requester for the
+ * objects it misses. The requester gathers the requested objects it holds
+ * into one generation and answers with random linear combinations of them
+ * over GF(2^8) instead of the objects themselves. Every broadcast coded
+ * packet is useful to every responder that still misses something of the
+ * generation, so a responder missing k of the objects decodes them from any
+ * k independent packets, whatever the others miss.
+ *
+ * Source symbol i of a generation is the wire encoding of object i,
+ * prefixed with its length as 2 big-endian bytes and zero-padded to the
+ * longest one. A coded packet is
+ *
+ *   item num, item num x (nid, seq), symbol size    (varints)
+ *   item num coefficient bytes
+ *   symbol size payload bytes
+ *
+ * so that every packet describes its generation.
+ */
+
+struct RepairItem {
+  NodeID nid;
+  uint64_t seq;
+};
+
+inline bool operator==(const RepairItem& l, const RepairItem& r) {
+  return l.nid == r.nid && l.seq == r.seq;
+}
+
+// item lists, as carried in repair requests and coded packets
+void AppendRepairItems(const std::vector<RepairItem>& items, std::string& out);
+const uint8_t* DecodeRepairItems(const uint8_t* begin, const uint8_t* end, std::vector<RepairItem>& items);
+
+class RepairEncoder {
+ public:
+  // largest object that fits the 2-byte length prefix
+  static const size_t kMaxObjectSize = 0xffff;
+
+  bool Contains(NodeID nid, uint64_t seq) const;
+
+  // adds an object to the generation; returns false if it is too large
+  bool Add(NodeID nid, uint64_t seq, const uint8_t* wire, size_t size);
+
+  size_t Size() const { return items_.size(); }
+  bool Empty() const { return items_.empty(); }
+  const std::vector<RepairItem>& Items() const { return items_; }
+
+  // a coded packet with coefficients drawn from @p rengine
+  std::string Encode(std::mt19937& rengine) const;
+
+  void Clear() {
+    items_.clear();
+    symbols_.clear();
+    symbol_size_ = 0;
+  }
+
+ private:
+  std::vector<RepairItem> items_;
+  std::vector<std::string> symbols_;  // unpadded, with the length prefix
+  size_t symbol_size_ = 0;
+};
+
+/**
+ * @brief Decodes one generation by incremental Gauss-Jordan elimination.
+ *
+ * Objects of the generation that the node already holds are looked up once
+ * with @p lookup and subtracted from every packet, so only the unknown ones
+ * take part in the elimination and as many independent packets are needed
+ * as objects are unknown.
+ */
+class RepairDecoder {
+ public:
+  // the wire encoding of an object the node holds, or false
+  using Lookup = std::function<bool(NodeID nid, uint64_t seq, std::string& wire)>;
+
+  explicit RepairDecoder(Lookup lookup)
+      : lookup_(std::move(lookup)) {}
+
+  /**
+   * @brief Adds a coded packet.
+   *
+   * The first packet sets the generation; a packet of another generation,
+   * or a malformed one, is rejected. Returns true if the packet raised the
+   * rank.
+   */
+  bool Add(const uint8_t* packet, size_t size);
+
+  bool Started() const { return started_; }
+  const std::vector<RepairItem>& Items() const { return items_; }
+  size_t Unknown() const { return unknown_.size(); }
+  size_t Rank() const { return rows_.size(); }
+  // unknown objects that still need an independent packet
+  size_t Missing() const { return unknown_.size() - rows_.size(); }
+  bool Complete() const { return started_ && Missing() == 0; }
+
+  // the decoded objects; only valid once Complete()
+  void ForEachDecoded(const std::function<void(NodeID nid, uint64_t seq, const uint8_t* wire, size_t size)>& f) const;
+
+ private:
+  bool Start(const std::vector<RepairItem>& items, size_t symbol_size);
+
+ private:
+  struct Row {
+    size_t pivot;                // index into unknown_
+    std::vector<uint8_t> coeff;  // over unknown_, 1 at pivot, 0 at the other pivots
+    std::vector<uint8_t> payload;
+  };
+
+  Lookup lookup_;
+  bool started_ = false;
+  std::vector<RepairItem> items_;
+  size_t symbol_size_ = 0;
+  std::vector<size_t> unknown_;               // generation indexes of the unknown objects
+  std::vector<int> column_;                   // per item: index into unknown_, or -1 if known
+  std::vector<std::vector<uint8_t>> known_;   // padded symbols of the known objects
+  std::vector<Row> rows_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_NETWORK_CODING_HPP_
@@ -1,5 +1,6 @@
 /* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
 
+#include <algorithm>
 #include <random>
 #include <fstream>
 
@@ -8,6 +9,7 @@
 #include <ndn-cxx/util/digest.hpp>
 
 #include "node.hpp"
+#include "device.hpp"
 #include "vsync-helper.hpp"
 #include "logging.hpp"
 
@@ -21,35 +23,166 @@ static int kSyncDelay = 4000;
 static int kInterestTransmissionTime = 3;
 
 static time::milliseconds kSyncDuration = time::milliseconds(150);
+// with adaptive sync duration (off by default, see SetAdaptiveSyncDuration),
+// size the awake window of the sync-requester from its responders instead
+// of keeping it kSyncDuration long: go to sleep WT after every responder
+// awake in the slot has ACKed; at the end of the window, stay awake while a
+// responder was heard within the last kSyncExtension, for kSyncExtension
+// plus one WT per data list chunk of the largest pending list announced in
+// the SyncACKs. The window never exceeds kMaxSyncDuration, a quarter of the
+// slot, whatever the responders announce.
+static const bool kDefaultAdaptiveSyncDuration = false;
+static const time::milliseconds kSyncExtension = time::milliseconds(50);
+static const time::milliseconds kMaxSyncDuration = time::milliseconds(kSyncDelay / 4);
+// initial DT max of the responders; WT, the lifetime of their interests and
+// the wait of the sync-requester for the first of them are one transmission
+// time more, and the interests joined on behalf of another node live 2 WT + 8.
+// With adaptive timers (off by default, see SetAdaptiveTimers), the window
+// is then resized from the contention seen in every slot (see
+// adaptive-timer.hpp).
 static int kInterestDT = 20;
-static time::milliseconds kWaitACKforSyncInterestInterval = time::milliseconds(kInterestDT + 3);
-static time::milliseconds kInterestWT = time::milliseconds(kInterestDT + 3);
-static int kSendOutInterestLifetime = kInterestDT + 3;
-static int kAddToPitInterestLifetime = 54;
+static const bool kDefaultAdaptiveTimers = false;
+
+// encode the version vector in sync interests as binary varints; set to false
+// to fall back to the dash-separated decimal string used by earlier runs
+static const bool kBinaryVVEncoding = true;
+// only ship the version vector entries that changed since the previous sync
+// interest of the same node (requires kBinaryVVEncoding)
+static const bool kDeltaVVSync = true;
+// let a responder whose state digest matches the one in the sync interest go
+// straight to the SyncACK without walking the version vector
+static const bool kStateDigestSync = true;
+// drop stored data that every member is known to have received; sequence
+// numbers within kGCSafetyMargin of the stable frontier are kept so that
+// late retransmissions can still be answered
+static const bool kStabilityGC = true;
+static const uint64_t kGCSafetyMargin = 5;
+// default retention policy of the data store (0 = unbounded); with a maximum
+// age, objects also expire at the end of their freshness period
+static const size_t kStoreByteBudget = 0;
+static const time::milliseconds kStoreMaxAge = time::milliseconds(0);
+// fetch a gap of more than one object with a single data list interest; the
+// reply bundles consecutive objects of up to kDataListBundleSize bytes, and
+// the rest of the gap is requested again from the first object not included
+static const bool kDataListFetch = true;
+static const size_t kDataListBundleSize = 1400;
+// keep a window of data interests in flight instead of waiting for each reply
+// in turn. The window grows by about one interest per window of replies while
+// no other node is heard fetching the same data, and halves on every loss
+// event (see FetchWindow). Only the first interest of a burst waits for the
+// DT timer.
+static const bool kPipelinedFetch = true;
+// objects asked for by one data list interest of a window, until the size of
+// the bundles is known
+static const uint64_t kDataListChunk = 8;
+// answer SyncACK interests with a kSyncReply bundle of the newest objects we
+// hold, up to kDataListBundleSize bytes. A responder missing at most
+// kSyncReplyMaxGap objects, all at the heads of their producers, sends its
+// SyncACK first and asks for them in it, so that the reply closes the gap in
+// one round trip.
+static const bool kSyncReplyPiggyback = true;
+static const uint64_t kSyncReplyMaxGap = 4;
+// push our own publications to the awake neighbours: the objects published
+// within kPushBatchWindow go out together as one data list, which satisfies
+// the push interest that every awake node keeps pending and is cached by the
+// others through the forwarder's unsolicited data policy
+static const bool kDefaultPush = false;
+static const time::milliseconds kPushBatchWindow = time::milliseconds(100);
+static const int kPushInterestLifetime = 2000;
+// order of the missing data in the pending list, see FetchOrder
+static const FetchOrder kDefaultFetchOrder = kProducerOrder;
+// network-coded repair (see network-coding.hpp): a responder missing at least
+// kRepairMinGap objects asks the sync-requester for up to kRepairMaxItems of
+// them in one repair request, waits WT for the requests of
+// the other responders to join the generation, then asks for coded packets
+// until it decodes, or gives up after kRepairExtraPackets more packets than
+// it missed objects. What the repair does not recover is fetched as before.
+static const bool kDefaultRepair = false;
+static const uint64_t kRepairMinGap = 2;
+static const size_t kRepairMaxItems = 32;
+static const size_t kRepairMaxGeneration = 64;
+static const uint64_t kRepairExtraPackets = 4;
+// set reconciliation (see iblt.hpp): the sync interest carries a strata
+// estimator of the requester's version vector instead of the vector, and a
+// responder whose state digest differs asks for an IBLT sized from the
+// estimated difference. A table that cannot be listed is asked for again
+// kIBLTRetries times, twice as large each time, before falling back to the
+// full version vector; so is a difference larger than the vector itself.
+static const bool kDefaultReconciliation = false;
+static const int kIBLTRetries = 2;
 
 static const int kSnapshotNum = 150;
 static time::milliseconds kSnapshotInterval = time::milliseconds(8000);
 static const std::string availabilityFileName = "availability.txt";
 
+// default interval between two publications of a node, in milliseconds
 static const int data_rate_lower_bound = 1000;
 static const int data_rate_upper_bound = 8000;
 
 Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
            const NodeID& nid, const Name& prefix, const GroupID& gid,
            const uint64_t group_size_, Node::DataCb on_data)
+           : Node(face, scheduler, key_chain, nid, prefix, gid, group_size_, std::move(on_data), nullptr) {
+}
+
+Node::Node(Device& device, const NodeID& nid, const Name& prefix, const GroupID& gid,
+           const uint64_t group_size_, Node::DataCb on_data)
+           : Node(device.GetFace(), device.GetScheduler(), device.GetKeyChain(), nid, prefix, gid, group_size_,
+                  std::move(on_data), &device) {
+}
+
+Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
+           const NodeID& nid, const Name& prefix, const GroupID& gid,
+           const uint64_t group_size_, Node::DataCb on_data, Device* device)
            : face_(face),
              key_chain_(key_chain),
              nid_(nid),
              scheduler_(scheduler),
+             timers_(scheduler),
              prefix_(prefix),
              gid_(name::Component(gid).toUri()),
              group_size(group_size_),
              data_cb_(std::move(on_data)),
+             device_(device),
+             inst_wt(timers_, [this] { SendInterest(); }),
+             inst_dt(timers_),
+             timer_(kInterestDT, kInterestTransmissionTime),
+             sync_interest_scheduler(timers_, [this] { SyncInterestTimeout(); }),
+             sync_duration_scheduler(timers_, [this] { OnSyncDurationTimeOut(); }),
+             sync_interest_retx_(0),
+             state_timer_(timers_, [this] { CheckState(); }),
+             intermediate_timer_(timers_, [this] { EnterIntermediateState(); }),
+             publish_timer_(timers_, [this] { PublishData(publish_content_); }),
+             push_timer_(timers_, [this] { PushPublications(); }),
+             snapshot_timer_(timers_, [this] { PrintVectorClock(); }),
              rengine_(rdevice_()),
              rdist_(3000, 10000) {
   version_vector_ = VersionVector(group_size, 0);
-  recv_window = std::vector<ReceiveWindow>(group_size);
-  // data_store_ = std::vector<std::vector<std::shared_ptr<Data>>>(group_size, std::vector<std::shared_ptr<Data>>(0));
+  other_vv_.reserve(group_size);
+  data_snapshots.reserve(kSnapshotNum);
+  vv_snapshots.reserve(kSnapshotNum);
+  rw_snapshots.reserve(kSnapshotNum);
+  store_snapshots.reserve(kSnapshotNum);
+  timer_snapshots.reserve(kSnapshotNum);
+  active_record.reserve(kSnapshotNum);
+  entry_digest_.assign(group_size, 0);
+  entry_complete_.assign(group_size, 1);
+  entry_horizon_.assign(group_size, 1);
+  state_digest_ = 0;
+  incomplete_num_ = 0;
+  for (NodeID i = 0; i < group_size; ++i) {
+    entry_digest_[i] = VVEntryDigest(i, 0);
+    state_digest_ += entry_digest_[i];
+  }
+  recv_window = ReceiveWindows(group_size);
+  gid_component_ = name::Component(gid_);
+  // on a device, the device dispatches our interests and holds our data
+  if (device_) data_store_ = device_->Join(this, gid_component_, group_size);
+  else data_store_ = GroupDataStore(group_size, kStoreByteBudget, kStoreMaxAge);
+  evicted_num_ = 0;
+  stable_vv_ = VersionVector(group_size, 0);
+  gc_token_ = VersionVector(group_size, 0);
+  gc_token_count_ = 0;
   node_state = kActive;
   energy_consumption = 0.0;
   sleeping_time = 0.0;
@@ -61,8 +194,63 @@ Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
   collision_num = 0;
   suppression_num = 0;
   out_interest_num = 0;
+  data_miss_num = 0;
+  data_sent_num_ = 0;
+  data_recv_num_ = 0;
   working_time = 0.0;
+  fetch_order_ = kDefaultFetchOrder;
+  push_ = kDefaultPush;
+  push_lo_ = 0;
+  push_interest_pending_ = false;
+  push_sent_num_ = 0;
+  push_recv_num_ = 0;
+  data_rate_lower_ = data_rate_lower_bound;
+  data_rate_upper_ = data_rate_upper_bound;
+  sync_reply_first_ = false;
+  sync_reply_from_ = VersionVector(group_size, 0);
+  fetch_window_ = FetchWindow();
+  fetch_timeout_num_ = 0;
+  data_list_chunk_ = kDataListChunk;
+  window_collision_num_ = 0;
+  window_suppression_num_ = 0;
+  repair_ = kDefaultRepair;
+  repairing_ = false;
+  repair_requester_ = 0;
+  repair_sync_index_ = 0;
+  repair_expected_ = 0;
+  repair_next_k_ = 0;
+  repair_last_k_ = 0;
+  repair_recovered_num_ = 0;
+  repair_frozen_ = false;
+  repair_sent_num_ = 0;
+  reconcile_ = kDefaultReconciliation;
+  iblt_state_digest_ = 0;
+  iblt_sync_requester_ = 0;
+  iblt_sync_index_ = 0;
+  iblt_retries_ = 0;
+  iblt_fail_num_ = 0;
+  iblt_fallback_num_ = 0;
+  sync_bytes_sent_ = 0;
+  sync_backlog_ = 0;
+  sync_cut_short_ = false;
+  sync_extended_num_ = 0;
+  sync_cut_short_num_ = 0;
+  adaptive_timers_ = kDefaultAdaptiveTimers;
+  adaptive_sync_duration_ = kDefaultAdaptiveSyncDuration;
+  timer_out_interest_num_ = 0;
+  timer_collision_num_ = 0;
+  timer_fetch_timeout_num_ = 0;
+  timer_suppression_num_ = 0;
+
+  if (device_ == nullptr) RegisterPrefixes();
+  scheduler_.scheduleEvent(time::milliseconds(2000), [this] { StartSimulation(); });
+}
+
+Node::~Node() {
+  if (device_) device_->Leave(this);
+}
 
+void Node::RegisterPrefixes() {
   face_.setInterestFilter(
       Name(kSyncPrefix).append(gid_), std::bind(&Node::OnSyncInterest, this, _2),
       [this](const Name&, const std::string& reason) {
@@ -78,6 +266,20 @@ Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
         throw Error("Failed to register data prefix: " + reason);
       });
 
+  face_.setInterestFilter(
+      Name(kSyncDataListPrefix).append(gid_), std::bind(&Node::OnDataInterest, this, _2),
+      [this](const Name&, const std::string& reason) {
+        VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Failed to register data list prefix: " << reason); 
+        throw Error("Failed to register data list prefix: " + reason);
+      });
+
+  face_.setInterestFilter(
+      Name(kSyncRepairPrefix).append(gid_), std::bind(&Node::OnRepairInterest, this, _2),
+      [this](const Name&, const std::string& reason) {
+        VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Failed to register repair prefix: " << reason); 
+        throw Error("Failed to register repair prefix: " + reason);
+      });
+
   face_.setInterestFilter(
       Name(kSyncACKPrefix).append(gid_), std::bind(&Node::OnSyncACKInterest, this, _2),
       [this](const Name&, const std::string& reason) {
@@ -85,6 +287,13 @@ Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
         throw Error("Failed to register sync ack interest prefix: " + reason);
       });
 
+  face_.setInterestFilter(
+      Name(kSyncVVPrefix).append(gid_), std::bind(&Node::OnVVInterest, this, _2),
+      [this](const Name&, const std::string& reason) {
+        VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Failed to register version vector prefix: " << reason); 
+        throw Error("Failed to register version vector prefix: " + reason);
+      });
+
   face_.setInterestFilter(
       Name(kIncomingDataPrefix), std::bind(&Node::OnIncomingData, this, _2),
       [this](const Name&, const std::string& reason) {
@@ -105,19 +314,83 @@ Node::Node(Face& face, Scheduler& scheduler, KeyChain& key_chain,
         VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Failed to register incomingSyncACK interest prefix: " << reason); 
         throw Error("Failed to register incomingSyncACK interest prefix: " + reason);
       });
+}
 
-  scheduler_.scheduleEvent(time::milliseconds(2000), [this] { StartSimulation(); });
+// the interests a Device dispatches to us, by the prefixes that
+// RegisterPrefixes() would register
+void Node::OnInterest(const Interest& interest) {
+  const auto& n = interest.getName();
+  if (kSyncPrefix.isPrefixOf(n)) OnSyncInterest(interest);
+  else if (kSyncDataPrefix.isPrefixOf(n) || kSyncDataListPrefix.isPrefixOf(n)) OnDataInterest(interest);
+  else if (kSyncRepairPrefix.isPrefixOf(n)) OnRepairInterest(interest);
+  else if (kSyncACKPrefix.isPrefixOf(n)) OnSyncACKInterest(interest);
+  else if (kSyncVVPrefix.isPrefixOf(n)) OnVVInterest(interest);
+  else if (kIncomingDataPrefix.isPrefixOf(n)) OnIncomingData(interest);
+  else if (kIncomingInterestPrefix.isPrefixOf(n)) OnIncomingInterest(interest);
+  else if (kIncomignSyncACKPrefix.isPrefixOf(n)) OnIncomingSyncACKInterest(interest);
+}
+
+void Node::SetRetentionPolicy(size_t max_bytes, time::milliseconds max_age) {
+  data_store_.SetRetention(max_bytes, max_age);
+}
+
+void Node::SetFetchOrder(FetchOrder order) {
+  fetch_order_ = order;
+}
+
+void Node::SetPush(bool push) {
+  push_ = push;
+}
+
+void Node::SetPublishRate(int lower, int upper) {
+  // an inverted range would make the distribution undefined
+  if (upper > 0 && lower > upper) std::swap(lower, upper);
+  data_rate_lower_ = lower;
+  data_rate_upper_ = upper;
+}
+
+void Node::SetNewDataCallback(NewDataCb on_new_data) {
+  new_data_cb_ = std::move(on_new_data);
+}
+
+void Node::SetRepair(bool repair) {
+  repair_ = repair;
+}
+
+void Node::SetReconciliation(bool reconcile) {
+  reconcile_ = reconcile;
+}
+
+void Node::SetAdaptiveTimers(bool adaptive) {
+  adaptive_timers_ = adaptive;
+}
+
+void Node::SetAdaptiveSyncDuration(bool adaptive) {
+  adaptive_sync_duration_ = adaptive;
+}
+
+void Node::EnablePersistence(const std::string& dir) {
+  data_log_.reset(new DataLog(dir));
+  // everything in the log survived the restart and does not need refetching
+  data_log_->ForEach([this] (NodeID nid, uint64_t seq) {
+    if (nid >= group_size || !recv_window[nid].Insert(seq)) return;
+    version_vector_[nid] = std::max(version_vector_[nid], seq);
+  });
+  for (NodeID i = 0; i < group_size; ++i) {
+    UpdateStateDigest(i);
+  }
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") recovered " << data_log_->Size() << " data from " << dir
+                   << ": version_vector=" << VersionVectorToString(version_vector_));
 }
 
 void Node::StartSimulation() {
+  // as if a slot just ended: CheckState() below starts slot 0 right away
+  slot_start_ = time::system_clock::now() - time::milliseconds(kSyncDelay);
   // at first, node(0) enter intermediate, and there are only other 2 active nodes.
   // if the kActiveInGroup = 3, node(1, 2) are active now. node(3) are waking up
   if (nid_ >= kActiveInGroup) {
     // node should go to sleep
-    Interest i(kLocalhostSleepingCommand);
-    face_.expressInterest(i, [](const Interest&, const Data&) {},
-                          [](const Interest&, const lp::Nack&) {},
-                          [](const Interest&) {});
+    RadioSleep();
     node_state = kSleeping;
     sleep_start = time::system_clock::now();
     VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") go to sleep" );
@@ -125,18 +398,18 @@ void Node::StartSimulation() {
   else {
     node_state = kActive;
     wakeup = time::system_clock::now();
+    ExpressPushInterest();
   }
 
   CheckState();
 
-  scheduler_.scheduleEvent(time::milliseconds(kSyncDelay * nid_),
-                           [this] { EnterIntermediateState(); });
+  intermediate_timer_.Arm(time::milliseconds(kSyncDelay * nid_));
 
-  scheduler_.scheduleEvent(time::milliseconds(3000), [this] { PrintVectorClock(); });
+  snapshot_timer_.Arm(time::milliseconds(3000));
 
   scheduler_.scheduleEvent(time::seconds(1200), [this] { SendGetOutVsyncInfoInterest(); });
 
-  PublishData("Hello from " + to_string(nid_));
+  if (data_rate_upper_ > 0) PublishData("Hello from " + to_string(nid_));
 }
 
 void Node::SendGetOutVsyncInfoInterest() {
@@ -148,29 +421,44 @@ void Node::SendGetOutVsyncInfoInterest() {
 
 void Node::PublishData(const std::string& content, uint32_t type) {
   if (node_state == kActive) {
-    // sequence number increases from 1, not 0
-    version_vector_[nid_]++;
+    Publish(reinterpret_cast<const uint8_t*>(content.data()), content.size(), type);
+  }
 
-    // make data dame
-    auto n = MakeDataName(gid_, nid_, version_vector_[nid_]);
-    std::shared_ptr<Data> data = std::make_shared<Data>(n);
-    data->setFreshnessPeriod(time::seconds(3600));
-    // set data content
-    data->setContent(reinterpret_cast<const uint8_t*>(content.data()),
-                     content.size());
-    data->setContentType(type);
-    key_chain_.sign(*data, signingWithSha256());
+  std::uniform_int_distribution<> data_rdist(data_rate_lower_, data_rate_upper_);
+  publish_content_ = content;
+  publish_timer_.Arm(time::milliseconds(data_rdist(rengine_)));
+}
 
-    // data_store_[nid_].push_back(data);
-    data_store_[n] = data;
-    recv_window[nid_].Insert(version_vector_[nid_]);
+void Node::PublishRelayed(const uint8_t* wire, size_t size) {
+  Publish(wire, size, kRelayedData);
+}
 
-    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Publish Data: d.name=" << n.toUri() << " d.type=" << type << " d.content=" << content);
+void Node::Publish(const uint8_t* content, size_t content_size, uint32_t type) {
+  // sequence number increases from 1, not 0
+  version_vector_[nid_]++;
+
+  // make data dame
+  auto n = MakeDataName(gid_, nid_, version_vector_[nid_]);
+  std::shared_ptr<Data> data = std::make_shared<Data>(n);
+  data->setFreshnessPeriod(time::seconds(3600));
+  // set data content
+  data->setContent(content, content_size);
+  data->setContentType(type);
+  key_chain_.sign(*data, signingWithSha256());
+
+  data_store_.Insert(nid_, version_vector_[nid_], data);
+  if (data_log_) data_log_->Append(nid_, version_vector_[nid_], data->wireEncode(), type);
+  recv_window[nid_].Insert(version_vector_[nid_]);
+  UpdateStateDigest(nid_);
+  OnEviction();
+
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Publish Data: d.name=" << n.toUri() << " d.type=" << type);
+
+  if (push_ && push_lo_ == 0) {
+    push_lo_ = version_vector_[nid_];
+    push_timer_.Arm(kPushBatchWindow);
   }
-
-  std::uniform_int_distribution<> data_rdist(data_rate_lower_bound, data_rate_upper_bound);
-  scheduler_.scheduleEvent(time::milliseconds(data_rdist(rengine_)),
-                           [this, content] { PublishData(content); });
+  if (new_data_cb_) new_data_cb_(nid_, version_vector_[nid_], *data);
 }
 
 /****************************************************************/
@@ -179,7 +467,7 @@ void Node::PublishData(const std::string& content, uint32_t type) {
 
 void Node::EnterIntermediateState() {
   assert(node_state == kActive);
-  scheduler_.scheduleEvent(time::milliseconds(group_size * kSyncDelay), [this] { EnterIntermediateState(); });
+  intermediate_timer_.Arm(time::milliseconds(group_size * kSyncDelay));
   // assert -> the NFD is working now!
   Reset();
   node_state = kIntermediate;
@@ -187,7 +475,9 @@ void Node::EnterIntermediateState() {
 }
 
 void Node::CheckState() {
-  scheduler_.scheduleEvent(time::milliseconds(kSyncDelay), [this] { CheckState(); });
+  state_timer_.Arm(time::milliseconds(kSyncDelay));
+  UpdateTimers();
+  slot_start_ = time::system_clock::now();
   time_slot++;
   if (time_slot == group_size) time_slot = 0;
   if (time_slot == nid_) {
@@ -197,16 +487,14 @@ void Node::CheckState() {
   else if ((time_slot + kActiveInGroup) % group_size == nid_) {
     // need to wake up
     assert(node_state == kSleeping);
-    Interest i(kLocalhostWakeupCommand);
-    face_.expressInterest(i, [](const Interest&, const Data&) {},
-                          [](const Interest&, const lp::Nack&) {},
-                          [](const Interest&) {});
+    RadioWakeup();
     node_state = kActive;
     auto cur_timepoint = time::system_clock::now();
     sleeping_time += time::toUnixTimestamp(cur_timepoint).count() - time::toUnixTimestamp(sleep_start).count();
     VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") wakeup" );
     Reset();
     wakeup = time::system_clock::now();
+    ExpressPushInterest();
   }
   else {
     bool isActive = false;
@@ -221,12 +509,9 @@ void Node::CheckState() {
     if (isActive == false) {
       if (node_state != kSleeping) {
         // force the node who doesn't finish the syncing to go to sleep
-        Interest i(kLocalhostSleepingCommand);
-        face_.expressInterest(i, [](const Interest&, const Data&) {},
-                              [](const Interest&, const lp::Nack&) {},
-                              [](const Interest&) {});
-        scheduler_.cancelEvent(sync_interest_scheduler);
-        scheduler_.cancelEvent(sync_duration_scheduler);
+        RadioSleep();
+        sync_interest_scheduler.Cancel();
+        sync_duration_scheduler.Cancel();
         node_state = kSleeping;
         VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") go to sleep" );
         sleep_start = time::system_clock::now();
@@ -241,15 +526,73 @@ void Node::CheckState() {
   }
 }
 
+void Node::UpdateTimers() {
+  AdaptiveTimer::Slot slot;
+  slot.sent = out_interest_num - timer_out_interest_num_;
+  slot.collisions = collision_num - timer_collision_num_;
+  slot.timeouts = fetch_timeout_num_ - timer_fetch_timeout_num_;
+  slot.suppressions = suppression_num - timer_suppression_num_;
+  slot.responders = slot_syncACK_responder_.size();
+  timer_out_interest_num_ = out_interest_num;
+  timer_collision_num_ = collision_num;
+  timer_fetch_timeout_num_ = fetch_timeout_num_;
+  timer_suppression_num_ = suppression_num;
+  slot_syncACK_responder_.clear();
+  if (!adaptive_timers_) return;
+  timer_.OnSlot(slot);
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") DT=" << timer_.DT() << " loss rate=" << timer_.LossRate()
+                   << " responders=" << timer_.Responders());
+}
+
+void Node::RadioSleep() {
+  if (device_) {
+    device_->Sleep(this);
+    return;
+  }
+  Interest i(kLocalhostSleepingCommand);
+  face_.expressInterest(i, [](const Interest&, const Data&) {},
+                        [](const Interest&, const lp::Nack&) {},
+                        [](const Interest&) {});
+}
+
+void Node::RadioWakeup() {
+  if (device_) {
+    device_->Wakeup(this);
+    return;
+  }
+  Interest i(kLocalhostWakeupCommand);
+  face_.expressInterest(i, [](const Interest&, const Data&) {},
+                        [](const Interest&, const lp::Nack&) {},
+                        [](const Interest&) {});
+}
+
+// CheckState() wakes us up when the slot kActiveInGroup before ours starts
+time::milliseconds Node::TimeToWakeup() const {
+  if (node_state != kSleeping) return time::milliseconds(0);
+  uint64_t wakeup_slot = (nid_ + group_size - kActiveInGroup % group_size) % group_size;
+  uint64_t next_slot = static_cast<uint32_t>(time_slot + 1) % group_size;
+  uint64_t slots = (wakeup_slot + group_size - next_slot) % group_size + 1;
+  auto elapsed = time::duration_cast<time::milliseconds>(time::system_clock::now() - slot_start_);
+  return std::max(time::milliseconds(kSyncDelay) * static_cast<int64_t>(slots) - elapsed, time::milliseconds(0));
+}
+
 void Node::Reset() {
-  pending_interest.clear();
-  scheduler_.cancelEvent(sync_interest_scheduler);
-  scheduler_.cancelEvent(sync_duration_scheduler);
-  scheduler_.cancelEvent(inst_dt);
-  scheduler_.cancelEvent(inst_wt);
+  pending_interest.Clear();
+  sync_interest_scheduler.Cancel();
+  sync_duration_scheduler.Cancel();
+  inst_dt.Cancel();
+  inst_wt.Cancel();
   sync_requester = false;
   sync_responder_success = false;
   receive_sync_interest = false;
+  sync_reply_first_ = false;
+  // replies to interests of the previous state are no longer counted
+  fetch_outstanding_.clear();
+  repairing_ = false;
+  repair_outstanding_.clear();
+  repair_decoder_.reset();
+  repair_encoder_.Clear();
+  repair_frozen_ = false;
 }
 
 /****************************************************************/
@@ -259,28 +602,35 @@ void Node::Reset() {
 /* SyncACK interest                                             */
 /****************************************************************/
 
-// record the syncACK delay, used for experiments, not the design part
+// counts the responders of the slot; at the sync-requester, also records the
+// syncACK delay, used for experiments, not the design part
 void Node::OnIncomingSyncACKInterest(const Interest& interest) {
-  if (sync_requester == false) return;
   const auto& n = interest.getName();
-  auto syncACK_receiver = n.get(-2).toNumber();
+  CountSyncACKResponder(n);
+  if (sync_requester == false) return;
+  name::Component gid;
+  NodeID syncACK_receiver, syncACK_responder;
+  uint64_t sync_index, pending_list_size;
+  if (!ParseSyncACKName(n, gid, syncACK_receiver, syncACK_responder, sync_index, pending_list_size)) return;
   if (syncACK_receiver != nid_) return;
 
   VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") receives incomingSyncACK Interest: name = " << n.toUri());
-
-  // extract the information from sign
-  const auto& sign = n.get(-1).toUri();
-  size_t sep1 = sign.find("-");
-  size_t sep2 = sign.find("-", sep1 + 1);
-  NodeID syncACK_responder = std::stoll(sign.substr(0, sep1));
-  uint64_t sync_index = std::stoll(sign.substr(sep1 + 1, sep2 - sep1 - 1));
-  size_t pending_list_size = std::stoll(sign.substr(sep2 + 1));
   // std::cout << n.toUri() << ": " << syncACK_responder << " " << sync_index << " " << pending_list_size << std::endl;
 
   assert(sync_index == sync_num);
 
+  OnSyncResponderActivity();
   if (receive_syncACK_responder.find(syncACK_responder) != receive_syncACK_responder.end()) return;
   receive_syncACK_responder.insert(syncACK_responder);
+  sync_backlog_ = std::max(sync_backlog_, pending_list_size);
+  // everyone awake is in sync: leave WT for a lost reply to be asked again
+  if (adaptive_sync_duration_ && !sync_cut_short_ && receive_syncACK_responder.size() >= ExpectedResponders()) {
+    sync_cut_short_ = true;
+    if (time::system_clock::now() + InterestWT() < sync_deadline_) {
+      sync_cut_short_num_++;
+      sync_duration_scheduler.Arm(InterestWT());
+    }
+  }
   if (receive_syncACK_responder.size() == 1) {
     time::system_clock::time_point receive_first_syncACK_time = time::system_clock::now();
     auto sync_ack_delay = time::toUnixTimestamp(receive_first_syncACK_time).count() - time::toUnixTimestamp(send_sync_interest_time).count();
@@ -294,6 +644,17 @@ void Node::OnIncomingSyncACKInterest(const Interest& interest) {
   }
 }
 
+// the channel may be shared with other groups, whose node IDs overlap ours
+void Node::CountSyncACKResponder(const Name& n) {
+  if (node_state == kSleeping) return;
+  name::Component gid;
+  NodeID sync_requester, sync_responder;
+  uint64_t sync_index, pending_list_size;
+  if (!ParseSyncACKName(n, gid, sync_requester, sync_responder, sync_index, pending_list_size)) return;
+  if (gid != gid_component_) return;
+  slot_syncACK_responder_.insert(sync_responder);
+}
+
 void Node::SyncData() {
   VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Start to Sync Data");
   sync_requester = true;
@@ -301,28 +662,73 @@ void Node::SyncData() {
   receive_syncACK_responder.clear();
   send_sync_interest_time = time::system_clock::now();
   sync_num++;
-
-  std::string vv_encode = EncodeVV(version_vector_);
-  auto sync_interest_name = MakeSyncInterestName(gid_, nid_, vv_encode, sync_num);
+  sync_backlog_ = 0;
+  sync_activity_time_ = send_sync_interest_time;
+  sync_cut_short_ = false;
+
+  name::Component stability_info;
+  if (kStabilityGC) {
+    VersionVector token;
+    uint64_t count = MakeStabilityToken(token);
+    PassStabilityToken(token, count);
+    stability_info = MakeStabilityInfo(token, count);
+  }
+  Name sync_interest_name;
+  if (reconcile_) {
+    StrataEstimator estimator;
+    for (const auto& item: VVItems(version_vector_)) estimator.Insert(item);
+    std::string encoded;
+    estimator.Encode(encoded);
+    sync_interest_name = MakeIBLTSyncInterestName(gid_, nid_, encoded, sync_num, state_digest_, stability_info);
+  }
+  else if (kBinaryVVEncoding && kDeltaVVSync && !last_sync_vv_.empty()) {
+    sync_interest_name = MakeDeltaSyncInterestName(gid_, nid_, VVDigest(last_sync_vv_),
+                                                   EncodeVVDelta(last_sync_vv_, version_vector_), sync_num,
+                                                   state_digest_, stability_info);
+  }
+  else if (kBinaryVVEncoding) {
+    sync_interest_name = MakeSyncInterestName(gid_, nid_, EncodeVVBinary(version_vector_), sync_num,
+                                              state_digest_, stability_info);
+  }
+  else {
+    std::string vv_encode = EncodeVV(version_vector_);
+    sync_interest_name = MakeSyncInterestName(gid_, nid_, vv_encode, sync_num, state_digest_, stability_info);
+  }
+  last_sync_vv_ = version_vector_;
 
   // set a timer for syncing-state
-  sync_duration_scheduler = scheduler_.scheduleEvent(kSyncDuration, [this] { OnSyncDurationTimeOut(); });
+  sync_duration_scheduler.Arm(kSyncDuration);
+  sync_deadline_ = send_sync_interest_time + kSyncDuration;
 
   SendSyncInterest(sync_interest_name, 0);
 
-  sync_interest_scheduler = scheduler_.scheduleEvent(kWaitACKforSyncInterestInterval, [this, sync_interest_name] {
-    this->SyncInterestTimeout(sync_interest_name, 1);
-  });
+  sync_interest_name_ = sync_interest_name;
+  sync_interest_retx_ = 1;
+  sync_interest_scheduler.Arm(InterestWT());
 }
 
 void Node::OnSyncDurationTimeOut() {
+  if (adaptive_sync_duration_ && !sync_cut_short_ && receive_syncACK_responder.size() < ExpectedResponders()) {
+    // responders heard lately are still fetching: give them the time their
+    // backlog needs, within the bound
+    auto now = time::system_clock::now();
+    auto awake = time::duration_cast<time::milliseconds>(now - send_sync_interest_time);
+    auto extension = kSyncExtension +
+                     InterestWT() * static_cast<int64_t>((sync_backlog_ + kDataListChunk - 1) / kDataListChunk);
+    extension = std::min(extension, kMaxSyncDuration - awake);
+    if (now - sync_activity_time_ < kSyncExtension && extension > time::milliseconds(0)) {
+      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") stays awake " << extension.count()
+                       << " ms more for its responders");
+      sync_extended_num_++;
+      sync_duration_scheduler.Arm(extension);
+      sync_deadline_ = now + extension;
+      return;
+    }
+  }
   // go to sleep
   VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") will go to sleep");
-  Interest i(kLocalhostSleepingCommand);
-  face_.expressInterest(i, [](const Interest&, const Data&) {},
-                        [](const Interest&, const lp::Nack&) {},
-                        [](const Interest&) {});
-  scheduler_.cancelEvent(sync_interest_scheduler);
+  RadioSleep();
+  sync_interest_scheduler.Cancel();
   node_state = kSleeping;
   sleep_start = time::system_clock::now();
 
@@ -333,6 +739,14 @@ void Node::OnSyncDurationTimeOut() {
   working_time += active_time;
 }
 
+size_t Node::ExpectedResponders() const {
+  return std::min<size_t>(kActiveInGroup, group_size - 1);
+}
+
+void Node::OnSyncResponderActivity() {
+  sync_activity_time_ = time::system_clock::now();
+}
+
 void Node::SendSyncInterest(const Name& sync_interest_name, const uint32_t& sync_interest_time) {
   // make the sync interest name
   if (sync_interest_time == 3) {
@@ -347,59 +761,44 @@ void Node::SendSyncInterest(const Name& sync_interest_name, const uint32_t& sync
   face_.expressInterest(i, [](const Interest&, const Data&) {},
                         [](const Interest&, const lp::Nack&) {},
                         [](const Interest&) {});
-  // if (sync_interest_size == 0) sync_interest_size = i.wireEncode().size();
+  sync_bytes_sent_ += i.wireEncode().size();
 }
 
-void Node::SyncInterestTimeout(const Name& sync_interest_name, const uint32_t& sync_interest_time) {
-  if (receive_ack_for_sync_interest == false) {
-    SendSyncInterest(sync_interest_name, sync_interest_time);
-    sync_interest_scheduler = scheduler_.scheduleEvent(kWaitACKforSyncInterestInterval, [this, sync_interest_name, sync_interest_time] {
-      this->SyncInterestTimeout(sync_interest_name, sync_interest_time + 1);
-    });
-  }
-  else {
-    scheduler_.cancelEvent(sync_interest_scheduler);
-    sync_interest_scheduler = scheduler_.scheduleEvent(kWaitACKforSyncInterestInterval, [this, sync_interest_name] {
-      this->SyncInterestTimeout(sync_interest_name, 0);
-    });
-  }
+void Node::SyncInterestTimeout() {
+  // once acknowledged, the sync interest is not sent again in this sync, so
+  // there is nothing left to poll for
+  if (receive_ack_for_sync_interest) return;
+  SendSyncInterest(sync_interest_name_, sync_interest_retx_);
+  sync_interest_retx_++;
+  sync_interest_scheduler.Arm(InterestWT());
 }
 
 void Node::OnSyncACKInterest(const Interest& interest) {
   const auto& n = interest.getName();
-  auto syncACK_receiver = ExtractNodeID(n);
-
   if (node_state == kSleeping) return;
-  else if (node_state == kActive) {
+  name::Component gid;
+  NodeID syncACK_receiver, syncACK_responder;
+  uint64_t sync_index;
+  if (!ParseSyncACKName(n, gid, syncACK_receiver, syncACK_responder, sync_index) || gid != gid_component_) return;
+
+  if (node_state == kActive) {
     if (sync_responder_success == true) {
       // send back the data to other sync_responder, because i have finished syncup data successfully
-      std::shared_ptr<Data> data = std::make_shared<Data>(n);
-      data->setFreshnessPeriod(time::seconds(3600));
-      key_chain_.sign(*data, signingWithSha256());
-      face_.put(*data);
+      SendSyncReply(n);
     }
     return;
   }
   else if (node_state == kIntermediate) {
-    // current one group
-    assert(syncACK_receiver == nid_);
+    // during our sync duration, a SyncACK for another requester or an
+    // earlier round is left alone
+    if (syncACK_receiver != nid_ || sync_index != sync_num) return;
     // VSYNC_LOG_TRACE( "sync-initializer (" << gid_ << " " << nid_ << ") Receive SyncACKInterest: i.name=" << n.toUri() );
-    const auto& sign = n.get(-1).toUri();
-    size_t sep1 = sign.find("-");
-    size_t sep2 = sign.find("-", sep1 + 1);
-    NodeID syncACK_responder = std::stoll(sign.substr(0, sep1));
-    uint64_t sync_index = std::stoll(sign.substr(sep1 + 1, sep2 - sep1 - 1));
-    size_t pending_list_size = std::stoll(sign.substr(sep2 + 1));
-    assert(sync_index == sync_num);
 
     VSYNC_LOG_TRACE( "sync-initializer (" << gid_ << " " << nid_ << ") Receive SyncACKInterest: i.name=" << n.toUri() << " from node " << syncACK_responder );
     assert(receive_syncACK_responder.find(syncACK_responder) != receive_syncACK_responder.end());
 
-    // send back an empty data to ack the syncACK_sender
-    std::shared_ptr<Data> data = std::make_shared<Data>(n);
-    data->setFreshnessPeriod(time::seconds(3600));
-    key_chain_.sign(*data, signingWithSha256());
-    face_.put(*data);
+    // ack the syncACK_sender, with the data it asked for and our newest data
+    SendSyncReply(n);
     /*
     if (receive_syncACK_responder.size() == 1) {
       std::shared_ptr<Data> data = std::make_shared<Data>(n);
@@ -407,12 +806,9 @@ void Node::OnSyncACKInterest(const Interest& interest) {
       key_chain_.sign(*data, signingWithSha256());
       face_.put(*data);
 
-      Interest i(kLocalhostSleepingCommand);
-      face_.expressInterest(i, [](const Interest&, const Data&) {},
-                            [](const Interest&, const lp::Nack&) {},
-                            [](const Interest&) {});
-      scheduler_.cancelEvent(sync_interest_scheduler);
-      scheduler_.cancelEvent(sync_duration_scheduler);
+      RadioSleep();
+      sync_interest_scheduler.Cancel();
+      sync_duration_scheduler.Cancel();
       node_state = kSleeping;
       VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") go to sleep" );
       sleep_start = time::system_clock::now();
@@ -434,47 +830,88 @@ void Node::OnSyncACKInterest(const Interest& interest) {
 /* SyncACK interest                                             
 /****************************************************************/
 void Node::OnIncomingData(const Interest& interest) {
+  Name incoming_data_name = Name("/ndn");
+  incoming_data_name.append(interest.getName().getSubName(2));
+  // pushed bundles answer the push interests, not our fetching
+  if (IsPushName(incoming_data_name)) return;
   if (node_state == kSleeping || node_state == kIntermediate) return;
-  else if (pending_interest.empty()) return;
+  else if (pending_interest.Empty()) return;
+  // while interests of the window are in flight, their replies and timeouts
+  // drive the fetching
+  else if (!fetch_outstanding_.empty()) return;
+  // and so do the coded packets during a repair
+  else if (repairing_) return;
   VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Schedule to send next interest");
   // cancel all interest timers:
-  scheduler_.cancelEvent(inst_dt);
-  scheduler_.cancelEvent(inst_wt);
+  inst_dt.Cancel();
+  inst_wt.Cancel();
   // send next pending interest
   SendInterest();
 }
 
 void Node::SendInterest() {
   // actually no need to cancel the timers again here, but to guarantee
-  scheduler_.cancelEvent(inst_dt);
-  scheduler_.cancelEvent(inst_wt);
+  inst_dt.Cancel();
+  inst_wt.Cancel();
   
-  std::uniform_int_distribution<> rdist2_(0, kInterestDT);
-  inst_dt = scheduler_.scheduleEvent(time::milliseconds(rdist2_(rengine_)),
+  inst_dt.Arm(RandomDT(),
     [this] {
-      assert(!pending_interest.empty());
-      while (!pending_interest.empty() && (data_store_.find(pending_interest.front().first) != data_store_.end() || pending_interest.front().second == 0)) {
-        if (data_store_.find(pending_interest.front().first) != data_store_.end()) {
-          VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") already has the data: name = " << pending_interest.front().first.toUri() );
+      assert(!pending_interest.Empty());
+      while (!pending_interest.Empty()) {
+        if (pending_interest.FrontIsData()) {
+          NodeID nid = pending_interest.FrontNodeID();
+          uint64_t seq = pending_interest.FrontSeq();
+          if (HasData(nid, seq)) {
+            VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") already has the data: node = " << nid << " seq = " << seq );
+          }
+          else if (IsEvicted(nid, seq)) {
+            VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") data is older than the retention horizon: node = " << nid << " seq = " << seq );
+          }
+          else if (pending_interest.FrontRetx() == 0) {
+            VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") has already retransmitted the data for three times: node = " << nid << " seq = " << seq );
+          }
+          else break;
         }
-        else {
-          VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") has already retransmitted the data for three times: data name = " << pending_interest.front().first.toUri() );
+        else if (pending_interest.FrontRetx() == 0) {
+          VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") has already retransmitted the data for three times: data name = " << pending_interest.ACKName().toUri() );
         }
-        pending_interest.erase(pending_interest.begin());
+        else break;
+        pending_interest.PopFront();
       }
-      if (pending_interest.empty()) {
-        scheduler_.cancelEvent(inst_dt);
-        scheduler_.cancelEvent(inst_wt);
+      if (pending_interest.Empty()) {
+        inst_dt.Cancel();
+        inst_wt.Cancel();
         sync_responder_success = true;
         return;
       }
-      auto n = pending_interest[0].first;
-      if (pending_interest[0].second != kInterestTransmissionTime) {
-        // add the collision_num (retransmission num)
-        collision_num++;
+      // a SyncACK that asks for the whole gap goes out before the data
+      bool ack_first = sync_reply_first_ && pending_interest.FrontIsData() && pending_interest.HasACK();
+      sync_reply_first_ = false;
+      if (kPipelinedFetch && pending_interest.FrontIsData() && !ack_first) {
+        FillFetchWindow();
+        return;
+      }
+      // the data name is only built now that it is about to be requested
+      Name n;
+      if (ack_first || !pending_interest.FrontIsData()) {
+        n = pending_interest.ACKName();
       }
-      pending_interest[0].second--;
-      Interest i(n, time::milliseconds(kSendOutInterestLifetime));
+      else if (kDataListFetch && pending_interest.FrontLastSeq() > pending_interest.FrontSeq()) {
+        n = MakeDataListName(gid_, pending_interest.FrontNodeID(), pending_interest.FrontSeq(),
+                             pending_interest.FrontLastSeq());
+      }
+      else {
+        n = MakeDataName(gid_, pending_interest.FrontNodeID(), pending_interest.FrontSeq());
+      }
+      // an early SyncACK leaves the budget of the front entry alone
+      if (!ack_first) {
+        if (pending_interest.FrontRetx() != pending_interest.FrontInitialRetx()) {
+          // add the collision_num (retransmission num)
+          collision_num++;
+        }
+        pending_interest.FrontRetx()--;
+      }
+      Interest i(n, InterestWT());
 
       VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send Interest: i.name=" << n.toUri());
 
@@ -483,52 +920,187 @@ void Node::SendInterest() {
                               [](const Interest&, const lp::Nack&) {},
                               [](const Interest&) {});
       }
+      else if (n.compare(0, 2, kSyncDataListPrefix) == 0) {
+        face_.expressInterest(i, std::bind(&Node::OnRemoteDataList, this, _2),
+                              [](const Interest&, const lp::Nack&) {},
+                              [](const Interest&) {});
+      }
       else if (n.compare(0, 2, kSyncACKPrefix) == 0) {
+        CountSyncACKResponder(n);
         face_.expressInterest(i, std::bind(&Node::OnDataForSyncack, this, _2),
                               [](const Interest&, const lp::Nack&) {},
                               [](const Interest&) {});
       }
       else assert(false);
 
-      scheduler_.cancelEvent(inst_dt);
-      scheduler_.cancelEvent(inst_wt);
+      inst_dt.Cancel();
+      inst_wt.Cancel();
       out_interest_num++;
       VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Reset WT " );
-      inst_wt = scheduler_.scheduleEvent(kInterestWT, [this] { SendInterest(); });
+      inst_wt.Arm(InterestWT());
     });
 }
 
+/****************************************************************/
+/* pipelined fetching of the pending data                       */
+/****************************************************************/
+void Node::FillFetchWindow() {
+  size_t window = static_cast<size_t>(fetch_window_.Size());
+  for (const auto& range: pending_interest.Ranges()) {
+    uint64_t lo = range.lo;
+    while (lo <= range.hi && fetch_outstanding_.size() < window) {
+      uint64_t hi = kDataListFetch ? std::min(range.hi, lo + data_list_chunk_ - 1) : lo;
+      // skip the objects already in flight, and stop before the next ones
+      bool in_flight = false;
+      for (const auto& fetch: fetch_outstanding_) {
+        if (fetch.nid != range.nid || fetch.hi < lo || fetch.lo > hi) continue;
+        if (fetch.lo <= lo) {
+          lo = fetch.hi + 1;
+          in_flight = true;
+          break;
+        }
+        hi = fetch.lo - 1;
+      }
+      if (in_flight) continue;
+      SendFetchInterest(range.nid, lo, hi);
+      lo = hi + 1;
+    }
+    if (fetch_outstanding_.size() >= window) break;
+  }
+}
+
+void Node::SendFetchInterest(NodeID nid, uint64_t lo, uint64_t hi) {
+  // the retransmission budget is kept for the front object of the list
+  if (pending_interest.FrontNodeID() == nid && pending_interest.FrontSeq() == lo) {
+    if (pending_interest.FrontRetx() != pending_interest.FrontInitialRetx()) collision_num++;
+    pending_interest.FrontRetx()--;
+  }
+  Name n = lo < hi ? MakeDataListName(gid_, nid, lo, hi) : MakeDataName(gid_, nid, lo);
+  Interest i(n, InterestWT());
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send Interest: i.name=" << n.toUri()
+                   << " window=" << fetch_window_.Size() << " in flight=" << fetch_outstanding_.size());
+  fetch_outstanding_.push_back(Fetch{nid, lo, hi, fetch_window_.OnSend()});
+  face_.expressInterest(i, std::bind(&Node::OnFetchData, this, _1, _2),
+                        [](const Interest&, const lp::Nack&) {},
+                        std::bind(&Node::OnFetchTimeout, this, _1));
+  out_interest_num++;
+}
+
+bool Node::EndFetch(const Name& n, uint64_t& serial) {
+  NodeID nid;
+  uint64_t lo, hi;
+  if (!ParseDataListName(n, nid, lo, hi) && !ParseDataName(n, nid, lo)) return false;
+  for (auto it = fetch_outstanding_.begin(); it != fetch_outstanding_.end(); ++it) {
+    if (it->nid == nid && it->lo == lo) {
+      serial = it->serial;
+      fetch_outstanding_.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Node::OnFetchData(const Interest& interest, const Data& data) {
+  uint64_t serial;
+  bool outstanding = EndFetch(interest.getName(), serial);
+  NodeID nid;
+  uint64_t lo, hi;
+  if (ParseDataListName(interest.getName(), nid, lo, hi)) {
+    // a bundle cut short tells how many objects fit in one; a full one lets
+    // the next interests ask for more
+    const auto& last = data.getName().get(-1);
+    if (data.getName().size() == interest.getName().size() + 1 && last.isNumber() &&
+        last.toNumber() >= lo && last.toNumber() <= hi) {
+      data_list_chunk_ = last.toNumber() < hi ? last.toNumber() - lo + 1 : data_list_chunk_ + 1;
+    }
+    OnRemoteDataList(data);
+  }
+  else {
+    OnRemoteData(data);
+  }
+  if (!outstanding || node_state != kActive || pending_interest.Empty()) return;
+
+  fetch_window_.OnReply(WindowContended());
+  if (pending_interest.FrontIsData()) FillFetchWindow();
+  // the window drained: start the next burst, or go on to the SyncACK
+  if (fetch_outstanding_.empty()) SendInterest();
+}
+
+void Node::OnFetchTimeout(const Interest& interest) {
+  uint64_t serial;
+  if (!EndFetch(interest.getName(), serial)) return;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Interest timeout: i.name=" << interest.getName().toUri());
+  fetch_timeout_num_++;
+  if (fetch_window_.OnTimeout(serial)) WindowContended();
+  if (node_state == kActive && !pending_interest.Empty() && fetch_outstanding_.empty()) SendInterest();
+}
+
+bool Node::WindowContended() {
+  // retransmissions or suppressed interests since the last adjustment mean
+  // other responders share the channel
+  bool contended = collision_num != window_collision_num_ || suppression_num != window_suppression_num_;
+  window_collision_num_ = collision_num;
+  window_suppression_num_ = suppression_num;
+  return contended;
+}
+
 void Node::OnIncomingInterest(const Interest& interest) {
+  Name incoming_interest_name = Name("/ndn");
+  incoming_interest_name.append(interest.getName().getSubName(2));
+  // the push interests of the awake nodes are no sign of a sync in progress
+  if (IsPushName(incoming_interest_name)) return;
+  if (kSyncACKPrefix.isPrefixOf(incoming_interest_name)) CountSyncACKResponder(incoming_interest_name);
+
   if (node_state == kSleeping) return;
   else if (node_state == kIntermediate) {
     receive_ack_for_sync_interest = true;
+    OnSyncResponderActivity();
+    return;
+  }
+  else if (pending_interest.Empty()) return;
+  else if (repairing_) {
+    // the coded packets another responder asks for are as useful to us as
+    // our own: join its interest instead of sending one more
+    uint64_t k;
+    if (InRepairRound(incoming_interest_name, k) && repair_outstanding_.count(k) == 0 &&
+        repair_outstanding_.size() < RepairWanted()) {
+      suppression_num++;
+      repair_outstanding_.insert(k);
+      Interest i(incoming_interest_name, PitLifetime());
+      face_.expressInterest(i, std::bind(&Node::OnCodedData, this, _1, _2),
+                            [](const Interest&, const lp::Nack&) {},
+                            std::bind(&Node::OnCodedTimeout, this, _1));
+    }
     return;
   }
-  else if (pending_interest.empty()) return;
   // cancel all interest timers:
-  scheduler_.cancelEvent(inst_dt);
-  scheduler_.cancelEvent(inst_wt);
+  inst_dt.Cancel();
+  inst_wt.Cancel();
 
-  Name incoming_interest_name = Name("/ndn");
-  incoming_interest_name.append(interest.getName().getSubName(2));
   VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Recv incomingInterest: name = " << incoming_interest_name.toUri() );
   // check if there exists the same pending interests
-  for (auto entry: pending_interest) {
-    auto interest_name = entry.first;
-    if (interest_name.compare(incoming_interest_name) == 0) {
-      suppression_num++;
-      Interest i(interest_name, time::milliseconds(kAddToPitInterestLifetime));
-      // VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send: i.name=" << interest_name.toUri());
-
-      face_.expressInterest(i, std::bind(&Node::OnRemoteData, this, _2),
-                            [](const Interest&, const lp::Nack&) {},
-                            [](const Interest&) {});
-      break;
-    }
+  // (a data list interest is the same request if its first object is pending)
+  NodeID node_id;
+  uint64_t seq, last;
+  bool is_list = ParseDataListName(incoming_interest_name, node_id, seq, last);
+  bool pending = (is_list || ParseDataName(incoming_interest_name, node_id, seq)) ?
+                 pending_interest.Contains(node_id, seq) :
+                 pending_interest.HasACK() && pending_interest.ACKName().compare(incoming_interest_name) == 0;
+  if (pending) {
+    suppression_num++;
+    Interest i(incoming_interest_name, PitLifetime());
+    // VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send: i.name=" << incoming_interest_name.toUri());
+
+    face_.expressInterest(i, [this, is_list](const Interest&, const Data& data) {
+                            if (is_list) OnRemoteDataList(data);
+                            else OnRemoteData(data);
+                          },
+                          [](const Interest&, const lp::Nack&) {},
+                          [](const Interest&) {});
   }
   // reset wt
   VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Reset WT " );
-  inst_wt = scheduler_.scheduleEvent(kInterestWT, [this] { SendInterest(); });
+  inst_wt.Arm(InterestWT());
 }
 
 void Node::OnSyncInterest(const Interest& interest) {
@@ -536,44 +1108,311 @@ void Node::OnSyncInterest(const Interest& interest) {
   if (receive_sync_interest == true) return;
   receive_sync_interest = true;
 
+  // drop expired data first, so that the state digest reflects what we can still fetch
+  ExpireData();
+
   const auto& n = interest.getName();
   auto sync_index = ExtractSyncIndex(n);
   auto sync_requester = ExtractNodeID(n);
-  auto other_vv_str = ExtractEncodedVV(n);
+  if (kStateDigestSync && incomplete_num_ == 0 && ExtractStateDigest(n) == state_digest_) {
+    // same version vector and we hold all of its data: nothing to fetch
+    VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Recv Sync Interest with matching state digest from node " << sync_requester);
+    if (kDeltaVVSync) requester_vv_[sync_requester] = version_vector_;
+    RecordNeighbourVV(version_vector_);
+    OnStabilityInfo(sync_requester, ExtractStabilityInfo(n), version_vector_);
+    pending_interest.PushACK(MakeSyncACKInterestName(gid_, sync_requester, nid_, sync_index, 0), 3);
+    SendInterest();
+    return;
+  }
 
-  VersionVector other_vv = DecodeVV(other_vv_str);
+  // decode into other_vv_, which keeps its capacity across sync interests
+  VersionVector& other_vv = other_vv_;
+  if (IsIBLTSyncInterestName(n)) {
+    // size the IBLT for the estimated difference; a difference as large as
+    // the group is cheaper to settle with the vector itself
+    StrataEstimator mine, theirs;
+    const auto& c = ExtractEncodedVVComponent(n);
+    if (!theirs.Decode(c.value(), c.value_size())) {
+      VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Malformed strata estimator in sync interest: " << n.toUri());
+      return;
+    }
+    for (const auto& item: VVItems(version_vector_)) mine.Insert(item);
+    size_t cells = IBLT::CellsFor(mine.Estimate(theirs));
+    vv_request_stability_ = ExtractStabilityInfo(n);
+    iblt_state_digest_ = ExtractStateDigest(n);
+    iblt_sync_requester_ = sync_requester;
+    iblt_sync_index_ = sync_index;
+    iblt_retries_ = 0;
+    if (cells > version_vector_.size()) {
+      iblt_fallback_num_++;
+      SendVVRequest(sync_requester, sync_index, kInterestTransmissionTime);
+    }
+    else {
+      SendIBLTRequest(sync_requester, sync_index, cells, kInterestTransmissionTime);
+    }
+    return;
+  }
+  else if (IsDeltaSyncInterestName(n)) {
+    // rebuild the requester's vector from the one it sent in its previous
+    // sync interest; ask for the full vector if we missed that one
+    auto base = requester_vv_.find(sync_requester);
+    if (base == requester_vv_.end() || VVDigest(base->second) != ExtractBaseDigest(n)) {
+      VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Unknown delta base from node " << sync_requester << ", request full version vector");
+      vv_request_stability_ = ExtractStabilityInfo(n);
+      SendVVRequest(sync_requester, sync_index, kInterestTransmissionTime);
+      return;
+    }
+    other_vv = base->second;
+    if (!ApplyVVDelta(ExtractEncodedVVComponent(n), other_vv)) {
+      VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Malformed version vector delta in sync interest: " << n.toUri());
+      return;
+    }
+  }
+  else if (kBinaryVVEncoding) {
+    if (!DecodeVVBinary(ExtractEncodedVVComponent(n), other_vv)) {
+      VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Malformed version vector in sync interest: " << n.toUri());
+      return;
+    }
+  }
+  else {
+    other_vv = DecodeVV(ExtractEncodedVV(n));
+  }
+  OnStabilityInfo(sync_requester, ExtractStabilityInfo(n), other_vv);
+  ProcessSyncVV(sync_requester, sync_index, other_vv);
+}
+
+void Node::ProcessSyncVV(const NodeID& sync_requester, uint64_t sync_index, const VersionVector& other_vv) {
   VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Recv Sync Interest: i.version_vector=" << VersionVectorToString(other_vv));
   if (other_vv.size() != version_vector_.size()) {
     VSYNC_LOG_TRACE("Different Version Vector Size in Group: " << gid_);
     return;
   }
-
-  for (NodeID i = 0; i < version_vector_.size(); ++i) {
-    uint64_t other_seq = other_vv[i];
-    // update vv
-    if (other_seq > version_vector_[i]) version_vector_[i] = other_seq;
-    ReceiveWindow::SeqNumIntervalSet missing_interval = recv_window[i].CheckForMissingData(version_vector_[i]);
-    if (missing_interval.empty()) continue;
-    auto it = missing_interval.begin();
-    while (it != missing_interval.end()) {
-      for (uint64_t seq = it->lower(); seq <= it->upper(); ++seq) {
-        //missing_data.push_back(MissingData(i, seq));
-        pending_interest.push_back(std::pair<Name, int>(MakeDataName(gid_, i, seq), kInterestTransmissionTime));
+  if (kDeltaVVSync) requester_vv_[sync_requester] = other_vv;
+  RecordNeighbourVV(other_vv);
+
+  // update vv; usually the requester has nothing newer than us
+  if (!Dominates(version_vector_, other_vv)) {
+    for (NodeID i = 0; i < version_vector_.size(); ++i) {
+      if (other_vv[i] > version_vector_[i]) {
+        version_vector_[i] = other_vv[i];
+        UpdateStateDigest(i);
       }
-      it++;
     }
   }
 
-  // add the syncACK interest to the last of the pending list
-  size_t pending_list_size = pending_interest.size();
-  pending_interest.push_back(std::pair<Name, int>(MakeSyncACKInterestName(gid_, sync_requester, nid_, sync_index, pending_list_size), 3));
+  // the receive windows keep their gaps up to date (their heads follow
+  // version_vector_, see UpdateStateDigest), so only read them off here
+  std::vector<FetchGap> gaps;
+  for (NodeID i = 0; i < version_vector_.size(); ++i) {
+    if (recv_window[i].MissingNum() == 0) continue;
+    // data below the retention horizon is no longer kept by anyone
+    uint64_t horizon = data_store_.RetentionHorizon(i);
+    recv_window[i].ForEachMissing(version_vector_[i], [i, horizon, &gaps] (uint64_t lo, uint64_t hi) {
+      if (hi >= horizon) gaps.push_back(FetchGap{i, std::max(lo, horizon), hi});
+    });
+  }
+  uint64_t missing = 0;
+  bool heads_only = true;
+  std::fill(sync_reply_from_.begin(), sync_reply_from_.end(), 0);
+  for (const auto& gap: gaps) {
+    missing += gap.hi - gap.lo + 1;
+    heads_only = heads_only && gap.hi == version_vector_[gap.nid];
+    sync_reply_from_[gap.nid] = gap.lo;
+  }
+  OrderFetchGaps(fetch_order_, gaps, version_vector_, neighbour_vv_, rengine_);
+  for (const auto& gap: gaps) {
+    pending_interest.PushData(gap.nid, gap.lo, gap.hi, kInterestTransmissionTime);
+  }
+
+  // add the syncACK interest to the last of the pending list; a small gap at
+  // the heads of the producers is asked for in the SyncACK itself
+  size_t pending_list_size = pending_interest.Size();
+  name::Component sync_reply_request;
+  if (kSyncReplyPiggyback && missing > 0 && missing <= kSyncReplyMaxGap && heads_only) {
+    sync_reply_request = EncodeSyncReplyRequest(sync_reply_from_);
+    sync_reply_first_ = true;
+  }
+  pending_interest.PushACK(MakeSyncACKInterestName(gid_, sync_requester, nid_, sync_index, pending_list_size,
+                                                   sync_reply_request), 3);
   // print the pending interest
   std::string pending_list = "";
-  for (auto entry: pending_interest) {
-    pending_list += entry.first.toUri() + "\n";
+  for (const auto& range: pending_interest.Ranges()) {
+    pending_list += "node " + to_string(range.nid) + ": " + to_string(range.lo) + "-" + to_string(range.hi) + "\n";
   }
+  pending_list += pending_interest.ACKName().toUri() + "\n";
   VSYNC_LOG_TRACE( "(node" << gid_ << ", " << nid_ << ") pending interest list = :\n" + pending_list);
-  SendInterest();
+  if (repair_ && !sync_reply_first_ && pending_interest.DataNum() >= kRepairMinGap) {
+    StartRepair(sync_requester, sync_index);
+  }
+  else {
+    SendInterest();
+  }
+}
+
+// keeps the version vectors of the last kActiveInGroup sync-requesters, the
+// neighbours that are most likely still awake
+void Node::RecordNeighbourVV(const VersionVector& vv) {
+  if (neighbour_vv_.size() == kActiveInGroup) neighbour_vv_.erase(neighbour_vv_.begin());
+  neighbour_vv_.push_back(vv);
+}
+
+void Node::SendVVRequest(const NodeID& sync_requester, uint64_t sync_index, int retx) {
+  if (retx == 0 || node_state != kActive || !pending_interest.Empty()) return;
+  auto n = MakeVVRequestName(gid_, sync_requester, sync_index);
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send VV request: i.name=" << n.toUri());
+  Interest i(n, InterestWT());
+  face_.expressInterest(i, std::bind(&Node::OnVVData, this, _2),
+                        [](const Interest&, const lp::Nack&) {},
+                        [this, sync_requester, sync_index, retx](const Interest&) {
+                          SendVVRequest(sync_requester, sync_index, retx - 1);
+                        });
+  out_interest_num++;
+  sync_bytes_sent_ += i.wireEncode().size();
+}
+
+void Node::SendIBLTRequest(const NodeID& sync_requester, uint64_t sync_index, size_t cells, int retx) {
+  if (node_state != kActive || !pending_interest.Empty()) return;
+  if (sync_requester != iblt_sync_requester_ || sync_index != iblt_sync_index_) return;
+  if (retx == 0) {
+    // no table came back: the sync is not lost as long as the vector gets through
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") No IBLT from node " << sync_requester
+                     << ", request full version vector");
+    iblt_fallback_num_++;
+    SendVVRequest(sync_requester, sync_index, kInterestTransmissionTime);
+    return;
+  }
+  // the table is rounded up to 3 * 2^k cells, so that responders with close
+  // estimates ask for the same table and their interests are aggregated
+  size_t rounded = IBLT::kHashNum;
+  while (rounded < cells) rounded *= 2;
+  auto n = MakeIBLTRequestName(gid_, sync_requester, sync_index, rounded);
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send IBLT request: i.name=" << n.toUri());
+  Interest i(n, InterestWT());
+  face_.expressInterest(i, std::bind(&Node::OnIBLTData, this, _2),
+                        [](const Interest&, const lp::Nack&) {},
+                        [this, sync_requester, sync_index, rounded, retx](const Interest&) {
+                          SendIBLTRequest(sync_requester, sync_index, rounded, retx - 1);
+                        });
+  out_interest_num++;
+  sync_bytes_sent_ += i.wireEncode().size();
+}
+
+void Node::OnVVInterest(const Interest& interest) {
+  // only the sync-requester answers, with the vector it sent in its sync interest
+  if (node_state != kIntermediate) return;
+  const auto& n = interest.getName();
+  NodeID sync_requester;
+  uint64_t sync_index;
+  size_t cells;
+  if (ParseIBLTRequestName(n, sync_requester, sync_index, cells)) {
+    if (sync_requester != nid_ || sync_index != sync_num) return;
+    receive_ack_for_sync_interest = true;
+    SendIBLT(n, cells);
+    return;
+  }
+  if (ExtractNodeID(n) != nid_ || ExtractSequence(n) != sync_num) return;
+  receive_ack_for_sync_interest = true;
+
+  auto vv_encode = EncodeVVBinary(last_sync_vv_);
+  std::shared_ptr<Data> data = std::make_shared<Data>(n);
+  data->setFreshnessPeriod(PitLifetime());
+  data->setContent(vv_encode.value(), vv_encode.value_size());
+  data->setContentType(kVectorClock);
+  key_chain_.sign(*data, signingWithSha256());
+  face_.put(*data);
+  sync_bytes_sent_ += data->wireEncode().size();
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the full version vector: name = " << n.toUri());
+}
+
+void Node::SendIBLT(const Name& n, size_t cells) {
+  // responders ask for at most the size of the vector, rounded up
+  if (cells == 0 || cells > 2 * last_sync_vv_.size()) return;
+  IBLT table(cells);
+  for (const auto& item: VVItems(last_sync_vv_)) table.Insert(item);
+  std::string encoded;
+  table.Encode(encoded);
+  std::shared_ptr<Data> data = std::make_shared<Data>(n);
+  data->setFreshnessPeriod(PitLifetime());
+  data->setContent(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size());
+  data->setContentType(kIBLT);
+  key_chain_.sign(*data, signingWithSha256());
+  face_.put(*data);
+  sync_bytes_sent_ += data->wireEncode().size();
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the IBLT of its version vector: name = " << n.toUri());
+}
+
+void Node::OnVVData(const Data& data) {
+  if (node_state != kActive || !pending_interest.Empty()) return;
+  const auto& n = data.getName();
+  const auto& content = data.getContent();
+  if (!DecodeVVBinary(content.value(), content.value_size(), other_vv_)) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed version vector: name = " << n.toUri());
+    return;
+  }
+  OnStabilityInfo(ExtractNodeID(n), vv_request_stability_, other_vv_);
+  ProcessSyncVV(ExtractNodeID(n), ExtractSequence(n), other_vv_);
+}
+
+void Node::OnIBLTData(const Data& data) {
+  if (node_state != kActive || !pending_interest.Empty()) return;
+  const auto& n = data.getName();
+  NodeID sync_requester;
+  uint64_t sync_index;
+  size_t cells;
+  if (!ParseIBLTRequestName(n, sync_requester, sync_index, cells)) return;
+  // a table of an earlier sync would be subtracted from the wrong state digest
+  if (sync_requester != iblt_sync_requester_ || sync_index != iblt_sync_index_) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Ignore IBLT of an earlier sync: name = " << n.toUri());
+    return;
+  }
+  const auto& content = data.getContent();
+  IBLT diff;
+  if (!diff.Decode(content.value(), content.value_size()) || diff.Cells() != cells) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed IBLT: name = " << n.toUri());
+    return;
+  }
+
+  // list (ours - theirs): the requester's vector is ours with the entries
+  // only we have replaced by the ones only it has, or 0
+  IBLT mine(cells);
+  for (const auto& item: VVItems(version_vector_)) mine.Insert(item);
+  mine.Subtract(diff);
+  std::vector<SetItem> ours, theirs;
+  bool listed = mine.List(ours, theirs);
+  VersionVector& other_vv = other_vv_;
+  uint64_t digest = state_digest_;
+  if (listed) {
+    other_vv = version_vector_;
+    auto update = [&other_vv, &digest] (NodeID i, uint64_t seq) {
+      digest -= VVEntryDigest(i, other_vv[i]);
+      other_vv[i] = seq;
+      digest += VVEntryDigest(i, other_vv[i]);
+    };
+    for (const auto& item: ours) {
+      if (item.nid >= other_vv.size() || other_vv[item.nid] != item.seq) listed = false;
+      else update(item.nid, 0);
+    }
+    for (const auto& item: theirs) {
+      if (item.nid >= other_vv.size() || other_vv[item.nid] != 0) listed = false;
+      else update(item.nid, item.seq);
+    }
+  }
+  // the digest also catches the rare table that lists wrong items
+  if (!listed || digest != iblt_state_digest_) {
+    iblt_fail_num_++;
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Cannot list IBLT of " << cells << " cells from node " << sync_requester);
+    if (iblt_retries_ < kIBLTRetries && cells <= version_vector_.size()) {
+      iblt_retries_++;
+      SendIBLTRequest(sync_requester, sync_index, cells * 2, kInterestTransmissionTime);
+    }
+    else {
+      iblt_fallback_num_++;
+      SendVVRequest(sync_requester, sync_index, kInterestTransmissionTime);
+    }
+    return;
+  }
+  OnStabilityInfo(sync_requester, vv_request_stability_, other_vv);
+  ProcessSyncVV(sync_requester, sync_index, other_vv);
 }
 
 void Node::OnDataInterest(const Interest& interest) {
@@ -583,76 +1422,593 @@ void Node::OnDataInterest(const Interest& interest) {
   const auto& n = interest.getName();
   VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Process Data Interest: i.name=" << n.toUri());
 
-  auto group_id = ExtractGroupID(n);
-  auto node_id = ExtractNodeID(n);
-  auto seq = ExtractSequence(n);
+  NodeID node_id;
+  uint64_t seq, last;
+  bool is_list = ParseDataListName(n, node_id, seq, last);
+  if (!is_list && !ParseDataName(n, node_id, seq)) return;
 
-  if(group_id != gid_) {
-    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Ignore data interest from different group: " << group_id);
+  // both prefixes have the same length, so the group ID is at the same place
+  if (n.get(kSyncDataPrefix.size()) != gid_component_) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Ignore data interest from different group: " << n.get(kSyncDataPrefix.size()).toUri());
     return;
   }
 
-  if (node_state == kActive) {
-    auto iter = data_store_.find(n);
-    if (iter != data_store_.end()) {
-      face_.put(*iter->second);
-      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the data name = " << iter->second->getName());
+  ExpireData();
+  if (node_state == kIntermediate) receive_ack_for_sync_interest = true;
+  if (is_list) {
+    SendDataList(n, node_id, seq, last);
+    return;
+  }
+  const auto& data = data_store_.Find(node_id, seq);
+  if (data) {
+    face_.put(*data);
+    data_sent_num_++;
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the data name = " << data->getName());
+    return;
+  }
+  auto wire = FindLogged(node_id, seq);
+  if (wire.first != nullptr) {
+    // the face only takes a Data, so the logged wire encoding is copied and
+    // decoded for every reply
+    face_.put(Data(Block(wire.first, wire.second)));
+    data_sent_num_++;
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the logged data name = " << n.toUri());
+  }
+  else if (seq < data_store_.RetentionHorizon(node_id)) {
+    data_miss_num++;
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") data has been evicted: name = " << n.toUri());
+  }
+}
+
+// answers a data list interest for objects [lo, hi] of producer nid with the
+// consecutive objects from lo on that we hold, as many as fit in one bundle
+void Node::SendDataList(const Name& n, NodeID nid, uint64_t lo, uint64_t hi) {
+  std::string content;
+  size_t num = EncodeDataList(nid, lo, hi, content);
+  if (num == 0) {
+    if (lo < data_store_.RetentionHorizon(nid)) {
+      data_miss_num++;
+      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") data has been evicted: name = " << n.toUri());
     }
+    return;
   }
-  else if (node_state == kIntermediate) {
-    receive_ack_for_sync_interest = true;
-    auto iter = data_store_.find(n);
-    // assert(iter != data_store_.end());
-    if (iter != data_store_.end()) {
-      face_.put(*iter->second);
-      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the data name = " << iter->second->getName());
+
+  // the reply names the last object it carries, so the requester knows where
+  // the next part of the range starts
+  uint64_t last = lo + num - 1;
+  std::shared_ptr<Data> data = std::make_shared<Data>(Name(n).appendNumber(last));
+  // another responder may hold a different part of the range
+  data->setFreshnessPeriod(PitLifetime());
+  data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  key_chain_.sign(*data, signingWithSha256());
+  face_.put(*data);
+  data_sent_num_++;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the data list name = " << data->getName()
+                   << " size = " << content.size());
+}
+
+// answers a SyncACK interest: first with the objects the sync-responder asked
+// for in it, then with the newest objects of every producer in turn, as many
+// as fit in one bundle
+size_t Node::EncodeDataList(NodeID nid, uint64_t lo, uint64_t hi, std::string& content) const {
+  std::vector<std::pair<uint32_t, std::string>> data_list;
+  size_t bundle_size = 0;
+  for (uint64_t seq = lo; seq <= hi; ++seq) {
+    uint32_t type;
+    auto wire = FindWire(nid, seq, type);
+    if (wire.first == nullptr) break;
+    // an object larger than the bundle still goes out on its own
+    if (!data_list.empty() && bundle_size + wire.second > kDataListBundleSize) break;
+    bundle_size += wire.second;
+    data_list.emplace_back(type, std::string(reinterpret_cast<const char*>(wire.first), wire.second));
+  }
+  EncodeDL(data_list, content);
+  return data_list.size();
+}
+
+void Node::SendSyncReply(const Name& n) {
+  std::vector<std::pair<uint32_t, std::string>> data_list;
+  size_t bundle_size = 0;
+  auto add = [this, &data_list, &bundle_size] (NodeID nid, uint64_t seq) {
+    uint32_t type;
+    auto wire = FindWire(nid, seq, type);
+    if (wire.first == nullptr || bundle_size + wire.second > kDataListBundleSize) return false;
+    bundle_size += wire.second;
+    data_list.emplace_back(type, std::string(reinterpret_cast<const char*>(wire.first), wire.second));
+    return true;
+  };
+
+  VersionVector& from = sync_reply_from_;
+  if (!ExtractSyncReplyRequest(n, from)) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed sync reply request: name = " << n.toUri());
+    std::fill(from.begin(), from.end(), 0);
+  }
+  for (NodeID i = 0; i < group_size; ++i) {
+    if (from[i] == 0) continue;
+    for (uint64_t seq = from[i]; seq <= version_vector_[i] && add(i, seq); ++seq) {}
+  }
+  // the requested objects are the newest ones of their producers
+  bool added = true;
+  for (uint64_t depth = 0; added && bundle_size < kDataListBundleSize; ++depth) {
+    added = false;
+    for (NodeID i = 0; i < group_size; ++i) {
+      if (from[i] != 0 || version_vector_[i] <= depth) continue;
+      added = add(i, version_vector_[i] - depth) || added;
     }
   }
+
+  std::string content;
+  EncodeDL(data_list, content);
+  std::shared_ptr<Data> data = std::make_shared<Data>(n);
+  data->setFreshnessPeriod(time::seconds(3600));
+  data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  data->setContentType(kSyncReply);
+  key_chain_.sign(*data, signingWithSha256());
+  face_.put(*data);
+  if (!data_list.empty()) data_sent_num_++;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the sync reply name = " << n.toUri()
+                   << " objects = " << data_list.size());
 }
 
-void Node::OnRemoteData(const Data& data) {
-  if (node_state == kSleeping || node_state == kIntermediate) return;
-  const auto& n = data.getName();
+/****************************************************************/
+/* network-coded repair                                         */
+/* The sync-requester gathers the objects asked for in the      */
+/* repair requests of the responders into one generation and    */
+/* answers every coded interest of the round with a new random  */
+/* combination of them. A responder asks for as many coded      */
+/* packets as it misses objects of the generation, and goes     */
+/* back to the pending list once it decoded them or gave up.    */
+/****************************************************************/
+void Node::OnRepairInterest(const Interest& interest) {
+  // only the sync-requester answers, during its own sync
+  if (node_state != kIntermediate) return;
+  const auto& n = interest.getName();
+  NodeID sync_requester;
+  uint64_t sync_index;
+  bool is_request;
+  if (!ParseRepairName(n, sync_requester, sync_index, is_request) || n.get(kSyncRepairPrefix.size()) != gid_component_ ||
+      sync_requester != nid_ || sync_index != sync_num) return;
+  receive_ack_for_sync_interest = true;
+
+  if (is_request) {
+    const auto& items_component = n.get(-1);
+    std::vector<RepairItem> items;
+    if (DecodeRepairItems(items_component.value(), items_component.value() + items_component.value_size(), items) == nullptr) {
+      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed repair request: name = " << n.toUri());
+      return;
+    }
+    // the reply tells how many of the objects the generation holds
+    uint64_t num = 0;
+    for (const auto& item: items) {
+      if (repair_encoder_.Contains(item.nid, item.seq)) {
+        num++;
+        continue;
+      }
+      if (repair_frozen_ || repair_encoder_.Size() == kRepairMaxGeneration || item.nid >= group_size) continue;
+      uint32_t type;
+      auto wire = FindWire(item.nid, item.seq, type);
+      if (wire.first != nullptr && repair_encoder_.Add(item.nid, item.seq, wire.first, wire.second)) num++;
+    }
+    uint8_t content[kMaxVarintSize];
+    std::shared_ptr<Data> data = std::make_shared<Data>(n);
+    data->setFreshnessPeriod(PitLifetime());
+    data->setContent(content, EncodeVarint(num, content));
+    key_chain_.sign(*data, signingWithSha256());
+    face_.put(*data);
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Recv repair request: name = " << n.toUri()
+                     << " objects = " << items.size() << " in generation = " << num);
+    return;
+  }
 
-  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Recv data: name=" << n.toUri());
+  if (repair_encoder_.Empty()) return;
+  repair_frozen_ = true;
+  std::string packet = repair_encoder_.Encode(rengine_);
+  std::shared_ptr<Data> data = std::make_shared<Data>(n);
+  data->setFreshnessPeriod(PitLifetime());
+  data->setContent(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+  key_chain_.sign(*data, signingWithSha256());
+  face_.put(*data);
+  repair_sent_num_++;
+  data_sent_num_++;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") sends the coded packet name = " << n.toUri()
+                   << " generation = " << repair_encoder_.Size() << " size = " << packet.size());
+}
 
-  // if (data_size == 0) data_size = data.wireEncode().size();
+void Node::StartRepair(const NodeID& sync_requester, uint64_t sync_index) {
+  std::vector<RepairItem> items;
+  for (const auto& range: pending_interest.Ranges()) {
+    for (uint64_t seq = range.lo; seq <= range.hi && items.size() < kRepairMaxItems; ++seq) {
+      items.push_back(RepairItem{range.nid, seq});
+    }
+    if (items.size() == kRepairMaxItems) break;
+  }
+  repairing_ = true;
+  repair_requester_ = sync_requester;
+  repair_sync_index_ = sync_index;
+  repair_expected_ = 0;
+  repair_next_k_ = 0;
+  repair_last_k_ = 0;
+  repair_outstanding_.clear();
+  repair_decoder_.reset(new RepairDecoder([this] (NodeID nid, uint64_t seq, std::string& wire) {
+    uint32_t type;
+    auto w = FindWire(nid, seq, type);
+    if (w.first == nullptr) return false;
+    wire.assign(reinterpret_cast<const char*>(w.first), w.second);
+    return true;
+  }));
+
+  std::string encoded;
+  AppendRepairItems(items, encoded);
+  repair_request_name_ = MakeRepairRequestName(gid_, sync_requester, sync_index, nid_, encoded);
+  inst_dt.Arm(RandomDT(), [this] { SendRepairRequest(repair_request_name_, kInterestTransmissionTime); });
+}
+
+void Node::SendRepairRequest(const Name& n, int retx) {
+  if (!repairing_) return;
+  if (retx == 0) {
+    FinishRepair();
+    return;
+  }
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send repair request: i.name=" << n.toUri());
+  Interest i(n, InterestWT());
+  uint64_t sync_index = repair_sync_index_;
+  face_.expressInterest(i,
+                        [this, sync_index](const Interest&, const Data& data) {
+                          if (!repairing_ || repair_sync_index_ != sync_index || repair_last_k_ != 0) return;
+                          const auto& content = data.getContent();
+                          uint64_t num = 0;
+                          DecodeVarint(content.value(), content.value() + content.value_size(), num);
+                          if (num == 0) {
+                            FinishRepair();
+                            return;
+                          }
+                          repair_expected_ = num;
+                          repair_last_k_ = num + kRepairExtraPackets;
+                          // let the requests of the other responders join the generation
+                          inst_dt.Arm(InterestWT() + RandomDT(), [this] { RequestCodedPackets(); });
+                        },
+                        [](const Interest&, const lp::Nack&) {},
+                        [this, n, retx, sync_index](const Interest&) {
+                          if (repairing_ && repair_sync_index_ == sync_index && repair_last_k_ == 0) {
+                            SendRepairRequest(n, retx - 1);
+                          }
+                        });
+  out_interest_num++;
+}
 
-  auto node_id = ExtractNodeID(n);
-  auto seq = ExtractSequence(n);
+size_t Node::RepairWanted() const {
+  return repair_decoder_->Started() ? repair_decoder_->Missing() : repair_expected_;
+}
 
-  if (data_store_.find(n) == data_store_.end()) {
-    // update the version_vector, data_store_ and recv_window
-    data_store_[n] = data.shared_from_this();
-    recv_window[node_id].Insert(seq);
+// tops up the coded interests in flight to the independent packets still needed
+void Node::RequestCodedPackets() {
+  if (!repairing_) return;
+  while (repair_outstanding_.size() < RepairWanted() && repair_next_k_ < repair_last_k_) {
+    if (repair_outstanding_.count(repair_next_k_) == 0) SendCodedInterest(repair_next_k_);
+    repair_next_k_++;
+  }
+  if (repair_outstanding_.empty()) FinishRepair();
+}
 
-    std::vector<std::pair<Name, int>>::iterator it = pending_interest.begin();
-    while (it != pending_interest.end()) {
-      if (it->first.compare(data.getName()) == 0) {
-        pending_interest.erase(it);
-        break;
-      }
-      it++;
+void Node::SendCodedInterest(uint64_t k) {
+  Name n = MakeRepairInterestName(gid_, repair_requester_, repair_sync_index_, k);
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Send coded interest: i.name=" << n.toUri());
+  repair_outstanding_.insert(k);
+  Interest i(n, InterestWT());
+  face_.expressInterest(i, std::bind(&Node::OnCodedData, this, _1, _2),
+                        [](const Interest&, const lp::Nack&) {},
+                        std::bind(&Node::OnCodedTimeout, this, _1));
+  out_interest_num++;
+}
+
+// true if @p n asks for coded packet @p k of our current repair round
+bool Node::InRepairRound(const Name& n, uint64_t& k) const {
+  NodeID sync_requester;
+  uint64_t sync_index;
+  bool is_request;
+  if (!repairing_ || !ParseRepairName(n, sync_requester, sync_index, is_request) || is_request) return false;
+  if (sync_requester != repair_requester_ || sync_index != repair_sync_index_) return false;
+  k = n.get(-1).toNumber();
+  return true;
+}
+
+void Node::OnCodedData(const Interest& interest, const Data& data) {
+  uint64_t k;
+  if (!InRepairRound(interest.getName(), k) || repair_outstanding_.erase(k) == 0) return;
+  const auto& content = data.getContent();
+  if (!repair_decoder_->Add(content.value(), content.value_size())) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") coded packet adds nothing: name = " << data.getName().toUri());
+  }
+  if (!repair_decoder_->Complete()) {
+    RequestCodedPackets();
+    return;
+  }
+
+  size_t num = 0;
+  repair_decoder_->ForEachDecoded([this, &num] (NodeID, uint64_t, const uint8_t* wire, size_t size) {
+    std::shared_ptr<Data> d;
+    try {
+      d = std::make_shared<Data>(Block(wire, size));
     }
+    catch (const std::exception& e) {
+      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed data in coded packets: " << e.what());
+      return;
+    }
+    if (OnRemoteData(*d)) num++;
+  });
+  repair_recovered_num_ += num;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") decoded " << num << " objects from "
+                   << repair_decoder_->Rank() << " coded packets");
+  FinishRepair();
+}
+
+void Node::OnCodedTimeout(const Interest& interest) {
+  uint64_t k;
+  if (!InRepairRound(interest.getName(), k) || repair_outstanding_.erase(k) == 0) return;
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Coded interest timeout: i.name=" << interest.getName().toUri());
+  RequestCodedPackets();
+}
+
+// back to the pending list, for what the repair did not recover and the SyncACK
+void Node::FinishRepair() {
+  repairing_ = false;
+  repair_outstanding_.clear();
+  repair_decoder_.reset();
+  if (node_state == kActive && !pending_interest.Empty()) SendInterest();
+}
+
+/****************************************************************/
+/* push of fresh publications                                   */
+/****************************************************************/
+void Node::PushPublications() {
+  uint64_t lo = push_lo_;
+  push_lo_ = 0;
+  if (node_state == kSleeping) return;
+  while (lo != 0 && lo <= version_vector_[nid_]) {
+    std::string content;
+    size_t num = EncodeDataList(nid_, lo, version_vector_[nid_], content);
+    if (num == 0) break;
+    std::shared_ptr<Data> data = std::make_shared<Data>(MakePushDataName(gid_, nid_, lo, lo + num - 1));
+    data->setFreshnessPeriod(PitLifetime());
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    key_chain_.sign(*data, signingWithSha256());
+    face_.put(*data);
+    data_sent_num_++;
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") pushes data name = " << data->getName());
+    push_sent_num_ += num;
+    lo += num;
   }
 }
 
+// keeps one push interest pending while we are awake
+void Node::ExpressPushInterest() {
+  if (!push_ || push_interest_pending_ || node_state == kSleeping) return;
+  push_interest_pending_ = true;
+  Interest i(MakePushInterestName(gid_), time::milliseconds(kPushInterestLifetime));
+  face_.expressInterest(i, std::bind(&Node::OnPushData, this, _2),
+                        [this](const Interest&, const lp::Nack&) {
+                          push_interest_pending_ = false;
+                          ExpressPushInterest();
+                        },
+                        [this](const Interest&) {
+                          push_interest_pending_ = false;
+                          ExpressPushInterest();
+                        });
+}
+
+void Node::OnPushData(const Data& data) {
+  push_interest_pending_ = false;
+  push_recv_num_ += OnRemoteDataList(data);
+  ExpressPushInterest();
+}
+
+size_t Node::OnRemoteDataList(const Data& data) {
+  if (node_state == kSleeping || node_state == kIntermediate) return 0;
+  const auto& content = data.getContent();
+  auto data_list = DecodeDL(content.value(), content.value_size());
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Recv data list: name=" << data.getName().toUri()
+                   << " objects=" << data_list.size());
+  size_t num = 0;
+  for (const auto& entry: data_list) {
+    std::shared_ptr<Data> d;
+    try {
+      d = std::make_shared<Data>(Block(reinterpret_cast<const uint8_t*>(entry.second.data()), entry.second.size()));
+    }
+    catch (const std::exception& e) {
+      VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Malformed data in data list: " << e.what());
+      break;
+    }
+    if (OnRemoteData(*d)) num++;
+  }
+  return num;
+}
+
+bool Node::OnRemoteData(const Data& data) {
+  if (node_state == kSleeping || node_state == kIntermediate) return false;
+  const auto& n = data.getName();
+
+  VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Recv data: name=" << n.toUri());
+
+  // if (data_size == 0) data_size = data.wireEncode().size();
+
+  NodeID node_id;
+  uint64_t seq;
+  if (!ParseDataName(n, node_id, seq) || node_id >= group_size) return false;
+  if (!recv_window[node_id].Accepts(seq)) {
+    VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Drop data too far ahead: name=" << n.toUri());
+    return false;
+  }
+
+  if (!data_store_.Insert(node_id, seq, data.shared_from_this())) return false;
+  if (data_log_) data_log_->Append(node_id, seq, data.wireEncode(), data.getContentType());
+  // update the version_vector, data_store_ and recv_window; pushed data can
+  // be newer than anything we have heard of
+  version_vector_[node_id] = std::max(version_vector_[node_id], seq);
+  recv_window[node_id].Insert(seq);
+  UpdateStateDigest(node_id);
+  OnEviction();
+
+  pending_interest.Remove(node_id, seq);
+  data_recv_num_++;
+  if (new_data_cb_) new_data_cb_(node_id, seq, data);
+  return true;
+}
+
 void Node::OnDataForSyncack(const Data& data) {
   // cancel dt & wt timers
   if (sync_responder_success == true) return;
-  if (pending_interest.size() == 1 && pending_interest.back().first.compare(data.getName()) == 0) {
+  if (!pending_interest.HasACK() || pending_interest.ACKName().compare(data.getName()) != 0) return;
+  // the data piggybacked on the reply may close the whole gap
+  if (data.getContentType() == kSyncReply) OnRemoteDataList(data);
+  if (pending_interest.OnlyACK()) {
     VSYNC_LOG_TRACE( "node(" << gid_ << " " << nid_ << ") Recv data for SyncACK, Stop Syncing" );
-    scheduler_.cancelEvent(inst_dt);
-    scheduler_.cancelEvent(inst_wt);
+    inst_dt.Cancel();
+    inst_wt.Cancel();
     sync_responder_success = true;
-    pending_interest.clear();
+    pending_interest.Clear();
+  }
+}
+
+std::pair<const uint8_t*, size_t> Node::FindWire(NodeID nid, uint64_t seq, uint32_t& type) const {
+  const auto& data = data_store_.Find(nid, seq);
+  if (data) {
+    const Block& block = data->wireEncode();
+    type = data->getContentType();
+    return {block.wire(), block.size()};
+  }
+  return FindLogged(nid, seq, type);
+}
+
+// the log keeps what the store evicted until its segment is reclaimed, but
+// serves nothing below the retention horizon
+std::pair<const uint8_t*, size_t> Node::FindLogged(NodeID nid, uint64_t seq) const {
+  if (!data_log_ || IsEvicted(nid, seq)) return {nullptr, 0};
+  return data_log_->Find(nid, seq);
+}
+
+std::pair<const uint8_t*, size_t> Node::FindLogged(NodeID nid, uint64_t seq, uint32_t& type) const {
+  if (!data_log_ || IsEvicted(nid, seq)) return {nullptr, 0};
+  return data_log_->Find(nid, seq, type);
+}
+
+bool Node::HasData(NodeID nid, uint64_t seq) const {
+  return data_store_.Has(nid, seq) || FindLogged(nid, seq).first != nullptr;
+}
+
+bool Node::IsEvicted(NodeID nid, uint64_t seq) const {
+  return seq < data_store_.RetentionHorizon(nid);
+}
+
+void Node::ExpireData() {
+  data_store_.Expire();
+  OnEviction();
+}
+
+// evictions move retention horizons, which changes what counts as complete
+void Node::OnEviction() {
+  if (data_store_.Evicted() == evicted_num_) return;
+  evicted_num_ = data_store_.Evicted();
+  // only the producers whose horizon moved
+  for (NodeID i = 0; i < group_size; ++i) {
+    uint64_t horizon = data_store_.RetentionHorizon(i);
+    if (horizon == entry_horizon_[i]) continue;
+    // what we never got below the horizon can no longer be fetched: stop
+    // waiting for it, so that the watermark follows the horizon
+    recv_window[i].AdvanceTo(horizon - 1);
+    UpdateStateDigest(i);
+  }
+  if (data_log_) data_log_->Reclaim([this] (NodeID nid) { return data_store_.RetentionHorizon(nid); });
+}
+
+void Node::UpdateStateDigest(NodeID i) {
+  recv_window[i].SetHead(version_vector_[i]);
+
+  state_digest_ -= entry_digest_[i];
+  entry_digest_[i] = VVEntryDigest(i, version_vector_[i]);
+  state_digest_ += entry_digest_[i];
+
+  // data below the retention horizon can no longer be fetched, so it does not count as missing
+  uint64_t horizon = data_store_.RetentionHorizon(i);
+  entry_horizon_[i] = horizon;
+  uint8_t complete = recv_window[i].MissingNum() == 0 || version_vector_[i] < horizon ||
+                     recv_window[i].HasAllDataIn(horizon, version_vector_[i]);
+  if (complete != entry_complete_[i]) {
+    if (complete) incomplete_num_--;
+    else incomplete_num_++;
+    entry_complete_[i] = complete;
+  }
+}
+
+/****************************************************************/
+/* garbage collection of the data store                         */
+/* Every sync interest carries a token with the element-wise    */
+/* minimum of the contiguously received prefixes of the nodes   */
+/* it has visited. Each node only hears the sync interest of    */
+/* its predecessor in the slot ring, so the token grows by one  */
+/* node per slot; once it covers the whole group, its entries   */
+/* are stable and the matching data can be dropped.             */
+/****************************************************************/
+// the token our sync interest carries: what we hold, merged into the token
+// of our predecessor; returns the number of members it covers
+uint64_t Node::MakeStabilityToken(VersionVector& token) const {
+  token.assign(group_size, 0);
+  for (NodeID i = 0; i < group_size; ++i) {
+    token[i] = recv_window[i].LastAckedData();
+  }
+  if (gc_token_count_ == 0 || gc_token_count_ >= group_size) return 1;
+  for (NodeID i = 0; i < group_size; ++i) {
+    token[i] = std::min(token[i], gc_token_[i]);
+  }
+  return gc_token_count_ + 1;
+}
+
+// hands the token on; one that covers the whole group is stable
+void Node::PassStabilityToken(const VersionVector& token, uint64_t count) {
+  gc_token_count_ = 0;
+  if (count < group_size) return;
+  MergeInto(stable_vv_, token);
+  CollectGarbage();
+}
+
+name::Component Node::MakeStabilityInfo(const VersionVector& token, uint64_t count) const {
+  return EncodeStabilityInfo(version_vector_, count, token, stable_vv_);
+}
+
+void Node::OnStabilityInfo(const NodeID& sender, const name::Component& info, const VersionVector& sender_vv) {
+  if (!kStabilityGC || info.empty() || sender_vv.size() != group_size) return;
+
+  uint64_t count;
+  VersionVector token, stable;
+  if (!DecodeStabilityInfo(info, sender_vv, count, token, stable)) {
+    VSYNC_LOG_TRACE("node(" << gid_ << " " << nid_ << ") Malformed stability info from node " << sender);
+    return;
+  }
+  MergeInto(stable_vv_, stable);
+  if (count >= group_size) {
+    MergeInto(stable_vv_, token);
+  }
+  else if ((sender + 1) % group_size == nid_) {
+    // we are the next sync-requester: carry the token on
+    gc_token_ = token;
+    gc_token_count_ = count;
+  }
+  CollectGarbage();
+}
+
+void Node::CollectGarbage() {
+  for (NodeID i = 0; i < group_size; ++i) {
+    if (stable_vv_[i] <= kGCSafetyMargin) continue;
+    data_store_.EvictUpTo(i, stable_vv_[i] - kGCSafetyMargin);
   }
+  OnEviction();
 }
 
 // print the vector clock every 5 seconds
 void Node::PrintVectorClock() {
   if (data_snapshots.size() == kSnapshotNum) return;
   data_snapshots.push_back(version_vector_[nid_]);
+  store_snapshots.push_back(data_store_.Bytes());
+  timer_snapshots.push_back(TimerSnapshot{timer_.DT(), timer_.LossRate(), timer_.Responders()});
   if (node_state != kSleeping) { 
     vv_snapshots.push_back(version_vector_);
     rw_snapshots.push_back(recv_window);
@@ -660,10 +2016,10 @@ void Node::PrintVectorClock() {
   }
   else {
     vv_snapshots.push_back(VersionVector(version_vector_.size(), 0));
-    rw_snapshots.push_back(std::vector<ReceiveWindow>(version_vector_.size()));
+    rw_snapshots.push_back(ReceiveWindows(version_vector_.size()));
     active_record.push_back(0);
   }
-  scheduler_.scheduleEvent(kSnapshotInterval, [this] { PrintVectorClock(); });
+  snapshot_timer_.Arm(kSnapshotInterval);
 }
   
 }  // namespace vsync
@@ -3,6 +3,7 @@
 #ifndef NDN_VSYNC_NODE_HPP_
 #define NDN_VSYNC_NODE_HPP_
 
+#include <cmath>
 #include <exception>
 #include <functional>
 #include <map>
@@ -16,14 +17,28 @@
 #include "vsync-common.hpp"
 #include "vsync-helper.hpp"
 #include "recv-window.hpp"
+#include "data-store.hpp"
+#include "data-log.hpp"
+#include "pending-list.hpp"
+#include "fetch-order.hpp"
+#include "network-coding.hpp"
+#include "iblt.hpp"
+#include "adaptive-timer.hpp"
+#include "fetch-window.hpp"
+#include "timer-wheel.hpp"
 
 namespace ndn {
 namespace vsync {
 
+class Device;
+
 class Node {
  public:
   using DataCb =
       std::function<void(const VersionVector& vv)>;
+  // object seq of member nid, as it enters the data store
+  using NewDataCb =
+      std::function<void(NodeID nid, uint64_t seq, const Data& data)>;
 
   enum DataType : uint32_t {
     kUserData = 0,
@@ -31,6 +46,8 @@ class Node {
     kSyncReply = 9668,
     kConfigureInfo = 9669,
     kVectorClock = 9670,
+    kIBLT = 9671,
+    kRelayedData = 9672,  // the content is the wire encoding of a Data of another group
   };
 
   enum NodeState : uint32_t {
@@ -64,12 +81,76 @@ class Node {
   Node(Face& face, Scheduler& scheduler, KeyChain& key_chain, const NodeID& nid,
        const Name& prefix, const GroupID& gid, const uint64_t group_size, DataCb on_data);
 
+  /**
+   * @brief Joins @p gid on a device in several groups: the node shares the
+   *        face, the data store and the radio of @p device with the nodes of
+   *        the other groups (see Device).
+   *
+   * @throw Error if @p device is already in @p gid
+   */
+  Node(Device& device, const NodeID& nid, const Name& prefix, const GroupID& gid,
+       const uint64_t group_size, DataCb on_data);
+
+  ~Node();
+
   const NodeID& GetNodeID() const { return nid_; };
 
   void PublishData(const std::string& content, uint32_t type = kUserData);
 
+  /**
+   * @brief Publishes the Data @p wire of another group now, as an object of
+   *        type kRelayedData, whether the node is awake or not; it is synced
+   *        with the other objects once the node is awake.
+   */
+  void PublishRelayed(const uint8_t* wire, size_t size);
+
+  // called for every object we publish or receive
+  void SetNewDataCallback(NewDataCb on_new_data);
+
   void SyncData();
 
+  /**
+   * @brief Bounds the data store by @p max_bytes of wire-encoded Data and
+   *        caps the lifetime of every object at @p max_age, or at its
+   *        freshness period if shorter. 0 disables the corresponding limit;
+   *        without a maximum age objects do not expire at all. On a
+   *        device, this sets the limits of the store of all its groups.
+   */
+  void SetRetentionPolicy(size_t max_bytes, time::milliseconds max_age);
+
+  /**
+   * @brief Logs every published and fetched Data to a memory-mapped log in
+   *        @p dir, and recovers the data already logged there by an earlier
+   *        run. Must be called before the simulation starts.
+   *
+   * @throw DataLog::Error if the log cannot be opened
+   */
+  void EnablePersistence(const std::string& dir);
+
+  // sets the order in which missing data is fetched; the default keeps producer order
+  void SetFetchOrder(FetchOrder order);
+
+  // turns the push of our own publications to awake neighbours on or off
+  void SetPush(bool push);
+
+  // publish a new object every [lower, upper] milliseconds, drawn uniformly;
+  // an upper bound of 0 turns the publications off
+  void SetPublishRate(int lower, int upper);
+
+  // turns network-coded repair of the missing data after a sync on or off
+  void SetRepair(bool repair);
+
+  // turns IBLT set reconciliation of the version vectors on or off
+  void SetReconciliation(bool reconcile);
+
+  // turns the sizing of the deferral window from the contention on or off;
+  // off, the window keeps its initial size
+  void SetAdaptiveTimers(bool adaptive);
+
+  // turns the sizing of the sync-requester's awake window from its
+  // responders on or off; off, the window is kSyncDuration long
+  void SetAdaptiveSyncDuration(bool adaptive);
+
   double GetEnergyConsumption() {
     return energy_consumption;
   }
@@ -86,10 +167,133 @@ class Node {
     return vv_snapshots;
   }
 
-  std::vector<std::vector<ReceiveWindow>> GetRWSnapshots() {
+  std::vector<ReceiveWindows> GetRWSnapshots() {
     return rw_snapshots;
   }
 
+  // data store memory usage, sampled together with the other snapshots
+  std::vector<size_t> GetStoreSnapshots() {
+    return store_snapshots;
+  }
+
+  // state of the deferral window controller, sampled with the other snapshots
+  struct TimerSnapshot {
+    double dt;
+    double loss_rate;
+    double responders;
+  };
+
+  std::vector<TimerSnapshot> GetTimerSnapshots() {
+    return timer_snapshots;
+  }
+
+  size_t GetStoreSize() const {
+    return data_store_.Size();
+  }
+
+  size_t GetStoreBytes() const {
+    return data_store_.Bytes();
+  }
+
+  size_t GetStorePeakBytes() const {
+    return data_store_.PeakBytes();
+  }
+
+  size_t GetEvictedNum() const {
+    return data_store_.Evicted();
+  }
+
+  // high-water marks of the pending list: entries (one per object) and ranges
+  size_t GetPendingPeak() const {
+    return pending_interest.PeakSize();
+  }
+
+  size_t GetPendingPeakRanges() const {
+    return pending_interest.PeakRangeNum();
+  }
+
+  // pipelined fetching: timed out data interests and the largest window reached
+  uint64_t GetFetchTimeoutNum() const {
+    return fetch_timeout_num_;
+  }
+
+  double GetFetchWindowPeak() const {
+    return fetch_window_.Peak();
+  }
+
+  // objects pushed to the neighbours, and objects received by push that we did not have
+  uint64_t GetPushSentNum() const {
+    return push_sent_num_;
+  }
+
+  uint64_t GetPushRecvNum() const {
+    return push_recv_num_;
+  }
+
+  // Data packets carrying objects that we sent, and objects we received that
+  // we did not have; their ratio over the group is the number of
+  // transmissions per recovered object
+  uint64_t GetDataSentNum() const {
+    return data_sent_num_;
+  }
+
+  uint64_t GetDataRecvNum() const {
+    return data_recv_num_;
+  }
+
+  // coded packets sent as sync-requester, and objects decoded from them
+  uint64_t GetRepairSentNum() const {
+    return repair_sent_num_;
+  }
+
+  uint64_t GetRepairRecoveredNum() const {
+    return repair_recovered_num_;
+  }
+
+  // bytes of sync state put on the air: sync interests, version vector and
+  // IBLT requests and their replies
+  uint64_t GetSyncBytesSent() const {
+    return sync_bytes_sent_;
+  }
+
+  // IBLTs that could not be listed, and reconciliations that fell back to
+  // the full version vector
+  uint64_t GetIBLTFailNum() const {
+    return iblt_fail_num_;
+  }
+
+  uint64_t GetIBLTFallbackNum() const {
+    return iblt_fallback_num_;
+  }
+
+  // syncs kept awake past the sync duration for responders still fetching,
+  // and syncs ended early because every expected responder had ACKed
+  uint64_t GetSyncExtendedNum() const {
+    return sync_extended_num_;
+  }
+
+  uint64_t GetSyncCutShortNum() const {
+    return sync_cut_short_num_;
+  }
+
+  // timers armed on the wheel, against the Scheduler events it used
+  uint64_t GetTimerArmNum() const {
+    return timers_.GetArmNum();
+  }
+
+  uint64_t GetSchedulerEventNum() const {
+    return timers_.GetSchedulerEventNum();
+  }
+
+  // data interests we could not answer because the data was evicted
+  uint64_t GetDataMissNum() const {
+    return data_miss_num;
+  }
+
+  const VersionVector& GetStableVV() const {
+    return stable_vv_;
+  }
+
   std::vector<std::pair<double, int>> ReceiveFirstSyncACKDelay() {
     /*
     double total = 0.0;
@@ -145,6 +349,10 @@ class Node {
   }
 
  private:
+  friend class Device;
+
+  Node(Face& face, Scheduler& scheduler, KeyChain& key_chain, const NodeID& nid,
+       const Name& prefix, const GroupID& gid, const uint64_t group_size, DataCb on_data, Device* device);
 
   Node(const Node&) = delete;
   Node& operator=(const Node&) = delete;
@@ -157,11 +365,37 @@ class Node {
   const GroupID gid_;
   uint32_t group_size;
   Scheduler& scheduler_;
+  // the timers below live on the wheel, which takes one Scheduler event at a
+  // time; see timer-wheel.hpp
+  SchedulerTimerWheel timers_;
 
   VersionVector version_vector_;
-  std::unordered_map<Name, std::shared_ptr<const Data>> data_store_;
-  std::vector<ReceiveWindow> recv_window;
+  VersionVector other_vv_;  // scratch space for decoding incoming version vectors
+  VersionVector last_sync_vv_;  // base of the next delta sync interest
+  std::unordered_map<NodeID, VersionVector> requester_vv_;  // last vector heard from each sync-requester
+  // digest of version_vector_ and completeness of recv_window, kept up to date
+  // by UpdateStateDigest(), which also moves the heads of recv_window along
+  // with version_vector_
+  MemberVector<uint64_t, kInlineGroupSize> entry_digest_;
+  MemberVector<uint8_t, kInlineGroupSize> entry_complete_;
+  MemberVector<uint64_t, kInlineGroupSize> entry_horizon_;  // retention horizon entry_complete_ was computed with
+  uint64_t state_digest_;
+  size_t incomplete_num_;
+  name::Component gid_component_;
+  GroupDataStore data_store_;
+  std::unique_ptr<DataLog> data_log_;  // optional persistent copy of the data
+  // garbage collection: stable_vv_[p] is a sequence number of producer p that
+  // every member has received (with everything before it). It is learned by
+  // passing a running minimum (gc_token_) around the sync-requester ring.
+  VersionVector stable_vv_;
+  VersionVector gc_token_;
+  uint64_t gc_token_count_;
+  name::Component vv_request_stability_;  // stability info of a delta sync interest whose base we missed
+  size_t evicted_num_;  // data_store_.Evicted() when the retention horizons were last checked
+  ReceiveWindows recv_window;
   DataCb data_cb_;
+  Device* device_;  // null for a node on its own
+  NewDataCb new_data_cb_;
   NodeState node_state;
   double energy_consumption;
   time::system_clock::time_point sleep_start;
@@ -169,24 +403,87 @@ class Node {
   uint64_t sleeping_time;
   double working_time;
   uint32_t time_slot;
+  time::system_clock::time_point slot_start_;
 
   std::vector<uint64_t> data_snapshots;
   std::vector<VersionVector> vv_snapshots;
-  std::vector<std::vector<ReceiveWindow>> rw_snapshots;
+  std::vector<ReceiveWindows> rw_snapshots;
+  std::vector<size_t> store_snapshots;
+  std::vector<TimerSnapshot> timer_snapshots;
   std::string outVsyncInfo;
   uint64_t collision_num;
   uint64_t suppression_num;
   uint64_t out_interest_num;
+  uint64_t data_miss_num;
+  uint64_t data_sent_num_;
+  uint64_t data_recv_num_;
   std::vector<uint64_t> active_record;
 
   // state for sync-responder
-  std::vector<std::pair<Name, int>> pending_interest;
+  PendingList pending_interest;
+  FetchOrder fetch_order_;
+  bool sync_reply_first_;  // send the SyncACK before the data it asks for
+  VersionVector sync_reply_from_;  // scratch space for sync reply requests
+  std::vector<VersionVector> neighbour_vv_;  // heard in the latest sync interests, oldest first
+
+  // state for pushing
+  bool push_;
+  uint64_t push_lo_;  // first of our objects waiting to be pushed, 0 if none
+  bool push_interest_pending_;
+  uint64_t push_sent_num_;
+  uint64_t push_recv_num_;
+  int data_rate_lower_;
+  int data_rate_upper_;
   bool sync_responder_success;
   bool receive_sync_interest;
   // timers for sync-responder interests
-  EventId inst_wt;
-  EventId inst_dt;
-
+  TimerWheel::Timer inst_wt;
+  TimerWheel::Timer inst_dt;
+  // sizes DT and WT from what the node saw in the previous slots; the
+  // counters are the totals at the end of the previous slot
+  bool adaptive_timers_;
+  AdaptiveTimer timer_;
+  uint64_t timer_out_interest_num_;
+  uint64_t timer_collision_num_;
+  uint64_t timer_fetch_timeout_num_;
+  uint64_t timer_suppression_num_;
+  std::unordered_set<uint64_t> slot_syncACK_responder_;  // heard in the current slot
+  // data interests in flight when fetching is pipelined, each for the
+  // objects [lo, hi] of producer nid
+  struct Fetch {
+    NodeID nid;
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t serial;  // order of sending
+  };
+  std::vector<Fetch> fetch_outstanding_;
+  FetchWindow fetch_window_;
+  uint64_t fetch_timeout_num_;
+  uint64_t data_list_chunk_;  // objects asked for by one data list interest
+  // collision_num and suppression_num at the last window adjustment
+  uint64_t window_collision_num_;
+  uint64_t window_suppression_num_;
+  // network-coded repair of one sync round: the coded packets asked for
+  // and not answered yet, by index
+  bool repair_;
+  bool repairing_;
+  NodeID repair_requester_;
+  uint64_t repair_sync_index_;
+  Name repair_request_name_;
+  size_t repair_expected_;  // objects of the request in the generation, until the first packet
+  uint64_t repair_next_k_;
+  uint64_t repair_last_k_;  // give up after asking for this many packets
+  std::set<uint64_t> repair_outstanding_;
+  std::unique_ptr<RepairDecoder> repair_decoder_;
+  uint64_t repair_recovered_num_;
+  // set reconciliation of the version vector of a sync interest
+  bool reconcile_;
+  uint64_t iblt_state_digest_;  // state digest of the sync interest being reconciled
+  NodeID iblt_sync_requester_;  // and its sync round
+  uint64_t iblt_sync_index_;
+  int iblt_retries_;
+  uint64_t iblt_fail_num_;
+  uint64_t iblt_fallback_num_;
 
   // state for sync-requester
   bool receive_ack_for_sync_interest;
@@ -197,11 +494,57 @@ class Node {
   std::vector<std::pair<double, int>> receive_last_syncACK_delay;
   std::vector<double> sync_delay;
   double sync_num;
+  // adaptive sync duration: the largest pending list announced in the
+  // SyncACKs of the sync, and when a responder was last heard
+  bool adaptive_sync_duration_;
+  size_t sync_backlog_;
+  time::system_clock::time_point sync_activity_time_;
+  time::system_clock::time_point sync_deadline_;  // when the sync duration timer fires
+  bool sync_cut_short_;
+  uint64_t sync_extended_num_;
+  uint64_t sync_cut_short_num_;
+  // generation of the repair round of the current sync; it no longer
+  // takes new objects once coded packets have gone out
+  RepairEncoder repair_encoder_;
+  bool repair_frozen_;
+  uint64_t repair_sent_num_;
+  uint64_t sync_bytes_sent_;
   // timers for sync-responder interests
-  EventId sync_interest_scheduler;
-  EventId sync_duration_scheduler;
+  TimerWheel::Timer sync_interest_scheduler;
+  TimerWheel::Timer sync_duration_scheduler;
+  Name sync_interest_name_;
+  uint32_t sync_interest_retx_;  // sync interests sent for the current sync
+  // periodic timers
+  TimerWheel::Timer state_timer_;
+  TimerWheel::Timer intermediate_timer_;
+  TimerWheel::Timer publish_timer_;
+  std::string publish_content_;
+  TimerWheel::Timer push_timer_;
+  TimerWheel::Timer snapshot_timer_;
+
+  void Publish(const uint8_t* content, size_t content_size, uint32_t type);
 
   // functions for sleeping scheduling
+  void RegisterPrefixes();
+  void OnInterest(const Interest& interest);
+  void RadioSleep();
+  void RadioWakeup();
+  time::milliseconds TimeToWakeup() const;
+
+  // feeds the deferral window controller with the slot that just ended
+  void UpdateTimers();
+  // the responder of a SyncACK interest, sent or heard
+  void CountSyncACKResponder(const Name& n);
+  time::milliseconds RandomDT() {
+    std::uniform_int_distribution<> dt_dist(0, static_cast<int>(timer_.DT()));
+    return time::milliseconds(dt_dist(rengine_));
+  }
+  time::milliseconds InterestWT() const {
+    return time::milliseconds(static_cast<int64_t>(std::ceil(timer_.WT())));
+  }
+  time::milliseconds PitLifetime() const {
+    return time::milliseconds(static_cast<int64_t>(std::ceil(timer_.PitLifetime())));
+  }
   inline void EnterIntermediateState();
   inline void CheckState();
   inline void Reset();
@@ -209,23 +552,72 @@ class Node {
   // functions for sync-requester
   inline void OnIncomingSyncACKInterest(const Interest& interest);
   inline void OnSyncDurationTimeOut();
+  // the responders awake during our slot
+  size_t ExpectedResponders() const;
+  void OnSyncResponderActivity();
   inline void SendSyncInterest(const Name& sync_interest_name, const uint32_t& sync_interest_time);
-  inline void SyncInterestTimeout(const Name& sync_interest_name, const uint32_t& sync_interest_time);
+  inline void SyncInterestTimeout();
   inline void OnSyncACKInterest(const Interest& interest);
+  void OnVVInterest(const Interest& interest);
 
   // functions for sync-responder
   inline void OnIncomingData(const Interest& interest);
   inline void OnIncomingInterest(const Interest& interest);
   inline void SendInterest();
+  void FillFetchWindow();
+  void SendFetchInterest(NodeID nid, uint64_t lo, uint64_t hi);
+  bool EndFetch(const Name& n, uint64_t& serial);
+  void OnFetchData(const Interest& interest, const Data& data);
+  void OnFetchTimeout(const Interest& interest);
+  // whether other nodes were heard fetching since the last window
+  // adjustment; counts from now on
+  bool WindowContended();
   void OnSyncInterest(const Interest& interest);
+  void ProcessSyncVV(const NodeID& sync_requester, uint64_t sync_index, const VersionVector& other_vv);
+  void RecordNeighbourVV(const VersionVector& vv);
+  void SendVVRequest(const NodeID& sync_requester, uint64_t sync_index, int retx);
+  void OnVVData(const Data& data);
+  void SendIBLTRequest(const NodeID& sync_requester, uint64_t sync_index, size_t cells, int retx);
+  void OnIBLTData(const Data& data);
+  void SendIBLT(const Name& n, size_t cells);
   void OnDataInterest(const Interest& interest);
-  void OnRemoteData(const Data& data);
+  void SendDataList(const Name& n, NodeID nid, uint64_t lo, uint64_t hi);
+  size_t EncodeDataList(NodeID nid, uint64_t lo, uint64_t hi, std::string& content) const;
+  size_t OnRemoteDataList(const Data& data);
+  void SendSyncReply(const Name& n);
+  bool OnRemoteData(const Data& data);
+  void PushPublications();
+  void ExpressPushInterest();
+  void OnPushData(const Data& data);
   inline void OnDataForSyncack(const Data& data);
+  void OnRepairInterest(const Interest& interest);
+  void StartRepair(const NodeID& sync_requester, uint64_t sync_index);
+  void SendRepairRequest(const Name& n, int retx);
+  void RequestCodedPackets();
+  void SendCodedInterest(uint64_t k);
+  bool InRepairRound(const Name& n, uint64_t& k) const;
+  size_t RepairWanted() const;
+  void OnCodedData(const Interest& interest, const Data& data);
+  void OnCodedTimeout(const Interest& interest);
+  void FinishRepair();
 
   // helper functions
   inline void StartSimulation();
   inline void SendGetOutVsyncInfoInterest();
   inline void PrintVectorClock();
+  std::pair<const uint8_t*, size_t> FindWire(NodeID nid, uint64_t seq, uint32_t& type) const;
+  std::pair<const uint8_t*, size_t> FindLogged(NodeID nid, uint64_t seq) const;
+  std::pair<const uint8_t*, size_t> FindLogged(NodeID nid, uint64_t seq, uint32_t& type) const;
+  inline bool HasData(NodeID nid, uint64_t seq) const;
+  inline bool IsEvicted(NodeID nid, uint64_t seq) const;
+  void ExpireData();
+  void OnEviction();
+  void UpdateStateDigest(NodeID i);
+  uint64_t MakeStabilityToken(VersionVector& token) const;
+  void PassStabilityToken(const VersionVector& token, uint64_t count);
+  name::Component MakeStabilityInfo(const VersionVector& token, uint64_t count) const;
+  void OnStabilityInfo(const NodeID& sender, const name::Component& info, const VersionVector& sender_vv);
+  void CollectGarbage();
   inline void ReceiveInterest();
   inline void ReceiveData();
 
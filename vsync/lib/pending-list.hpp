@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_PENDING_LIST_HPP_
+#define NDN_VSYNC_PENDING_LIST_HPP_
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * @brief Pending list of a sync-responder: the missing data it still has to
+ *        fetch, followed by its SyncACK interest.
+ *
+ * Missing data is held as ranges [lo, hi] of one producer's sequence
+ * numbers, so a sync that finds thousands of missing objects only stores
+ * one entry per gap. The data Name of an object is built by the caller when
+ * the object reaches the front of the list and is about to be requested.
+ *
+ * Every object carries its own retransmission budget; only the front object
+ * of each range can have used part of it.
+ *
+ * The ranges form a linked list in fetch order, and each producer has an
+ * index of its ranges keyed by their last sequence number. Looking up,
+ * removing or splitting a range is a single index lookup, and dequeueing
+ * is O(1). The lookup cost grows with the number of gaps of one producer,
+ * not with the number of missing objects. Data that is already pending is
+ * not added again.
+ */
+class PendingList {
+ public:
+  struct Range {
+    NodeID nid;
+    uint64_t lo;
+    uint64_t hi;
+    int retx;  // budget of each object
+    int lo_retx;  // budget left for lo
+  };
+
+  bool Empty() const {
+    return ranges_.empty() && !has_ack_;
+  }
+
+  // number of entries, counting every data object separately
+  size_t Size() const {
+    return data_num_ + (has_ack_ ? 1 : 0);
+  }
+
+  size_t DataNum() const {
+    return data_num_;
+  }
+
+  void Clear() {
+    ranges_.clear();
+    index_.clear();
+    data_num_ = 0;
+    has_ack_ = false;
+    ack_name_ = Name();
+  }
+
+  /**
+   * @brief Appends the objects [lo, hi] of producer @p nid, before the
+   *        SyncACK. Objects that are already pending keep their place.
+   */
+  void PushData(NodeID nid, uint64_t lo, uint64_t hi, int retx) {
+    if (nid >= index_.size()) index_.resize(nid + 1);
+    auto& index = index_[nid];
+    // skip the parts of [lo, hi] covered by pending ranges
+    auto it = index.lower_bound(lo);
+    while (lo <= hi) {
+      if (it != index.end() && it->second->lo <= lo) {
+        lo = it->first + 1;
+        ++it;
+        continue;
+      }
+      uint64_t end = it != index.end() ? std::min(hi, it->second->lo - 1) : hi;
+      auto r = ranges_.insert(ranges_.end(), Range{nid, lo, end, retx, retx});
+      index.emplace(end, r);
+      data_num_ += end - lo + 1;
+      lo = end + 1;
+    }
+    OnGrow();
+  }
+
+  // sets the SyncACK interest, which always stays at the end of the list
+  void PushACK(const Name& n, int retx) {
+    has_ack_ = true;
+    ack_name_ = n;
+    ack_retx_ = retx;
+    ack_retx_init_ = retx;
+    OnGrow();
+  }
+
+  bool FrontIsData() const {
+    return !ranges_.empty();
+  }
+
+  // the front object; only valid if FrontIsData()
+  NodeID FrontNodeID() const {
+    return ranges_.front().nid;
+  }
+
+  uint64_t FrontSeq() const {
+    return ranges_.front().lo;
+  }
+
+  // last object of the front range, which is fetched together with it
+  uint64_t FrontLastSeq() const {
+    return ranges_.front().hi;
+  }
+
+  // retransmission budget left for the front entry
+  int& FrontRetx() {
+    return FrontIsData() ? ranges_.front().lo_retx : ack_retx_;
+  }
+
+  int FrontInitialRetx() const {
+    return FrontIsData() ? ranges_.front().retx : ack_retx_init_;
+  }
+
+  bool HasACK() const {
+    return has_ack_;
+  }
+
+  const Name& ACKName() const {
+    return ack_name_;
+  }
+
+  // only the SyncACK is left
+  bool OnlyACK() const {
+    return ranges_.empty() && has_ack_;
+  }
+
+  void PopFront() {
+    if (ranges_.empty()) {
+      has_ack_ = false;
+      return;
+    }
+    Remove(ranges_.front().nid, ranges_.front().lo);
+  }
+
+  bool Contains(NodeID nid, uint64_t seq) const {
+    if (nid >= index_.size()) return false;
+    auto it = index_[nid].lower_bound(seq);
+    return it != index_[nid].end() && it->second->lo <= seq;
+  }
+
+  // removes object @p seq of producer @p nid; returns false if it is not pending
+  bool Remove(NodeID nid, uint64_t seq) {
+    if (nid >= index_.size()) return false;
+    auto& index = index_[nid];
+    auto it = index.lower_bound(seq);
+    if (it == index.end() || it->second->lo > seq) return false;
+    auto r = it->second;
+    data_num_--;
+    if (r->lo == r->hi) {
+      ranges_.erase(r);
+      index.erase(it);
+    }
+    else if (seq == r->lo) {
+      r->lo++;
+      r->lo_retx = r->retx;
+    }
+    else if (seq == r->hi) {
+      r->hi--;
+      index.erase(it);
+      index.emplace(r->hi, r);
+    }
+    else {
+      // split; the upper part keeps the place right after the lower one
+      auto tail = ranges_.insert(std::next(r), Range{nid, seq + 1, r->hi, r->retx, r->retx});
+      it->second = tail;
+      r->hi = seq - 1;
+      index.emplace(r->hi, r);
+      OnGrow();
+    }
+    return true;
+  }
+
+  const std::list<Range>& Ranges() const {
+    return ranges_;
+  }
+
+  // high-water marks of Size() and of the number of ranges since construction
+  size_t PeakSize() const {
+    return peak_size_;
+  }
+
+  size_t PeakRangeNum() const {
+    return peak_range_num_;
+  }
+
+ private:
+  void OnGrow() {
+    peak_size_ = std::max(peak_size_, Size());
+    peak_range_num_ = std::max(peak_range_num_, ranges_.size());
+  }
+
+  std::list<Range> ranges_;
+  // per producer: last sequence number of each pending range -> the range
+  std::vector<std::map<uint64_t, std::list<Range>::iterator>> index_;
+  size_t data_num_ = 0;
+  size_t peak_size_ = 0;
+  size_t peak_range_num_ = 0;
+  bool has_ack_ = false;
+  Name ack_name_;
+  int ack_retx_ = 0;
+  int ack_retx_init_ = 0;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_PENDING_LIST_HPP_
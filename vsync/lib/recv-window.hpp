@@ -3,10 +3,12 @@
 #ifndef NDN_VSYNC_RECV_WINDOW_HPP_
 #define NDN_VSYNC_RECV_WINDOW_HPP_
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <boost/icl/interval_set.hpp>
 
@@ -82,11 +84,19 @@ class ReceiveWindow {
   }
 
   bool HasAllDataBefore(uint64_t seq) const {
-    return win.iterative_size() >= 1 && win.begin()->upper() >= seq;
+    return win.iterative_size() >= 1 && win.begin()->lower() == 1 &&
+           win.begin()->upper() >= seq;
+  }
+
+  // every sequence number in [lo, hi] has been received
+  bool HasAllDataIn(uint64_t lo, uint64_t hi) const {
+    if (lo > hi) return true;
+    auto it = win.find(lo);
+    return it != win.end() && it->upper() >= hi;
   }
 
   uint64_t LastAckedData() const {
-    if (win.empty())
+    if (win.empty() || win.begin()->lower() != 1)
       return 0;
     else
       return win.begin()->upper();
@@ -110,6 +120,218 @@ class ReceiveWindow {
 
 };
 
+/**
+ * @brief Receive window with the same interface as ReceiveWindow, stored as
+ *        a watermark plus a bitmap.
+ *
+ * Every sequence number up to the watermark has been received; the bitmap
+ * only covers the out-of-order tail after it, with bit k standing for
+ * sequence number LastAckedData() + 1 + k. Sequence numbers mostly arrive in
+ * order, so the usual insert just bumps the watermark and needs neither an
+ * allocation nor a tree walk.
+ *
+ * The window also tracks the highest sequence number known to exist (the
+ * head, advanced by SetHead or by inserting past it) and keeps the number of
+ * missing sequence numbers up to the head current on every insert, so the
+ * gaps can be read off without recomputing them from the whole history.
+ *
+ * A sequence number more than kMaxSeqGap past the watermark is refused, so a
+ * bogus one cannot grow the bitmap without bound.
+ */
+class BitmapReceiveWindow {
+ public:
+  using SeqNumInterval = ReceiveWindow::SeqNumInterval;
+  using SeqNumIntervalSet = ReceiveWindow::SeqNumIntervalSet;
+
+  // @return false if @p seq is too far past the watermark to be recorded
+  bool Insert(uint64_t seq) {
+    if (seq <= acked_) return true;
+    uint64_t k = seq - acked_ - 1;
+    if (k >= kMaxSeqGap) return false;
+    if (Test(k)) return true;
+    if (seq <= head_) {
+      missing_--;
+    }
+    else {
+      missing_ += seq - head_ - 1;
+      head_ = seq;
+    }
+    if (k == 0 && bits_.empty()) {
+      acked_++;
+      return true;
+    }
+    size_t w = k / 64;
+    if (w >= bits_.size()) bits_.resize(w + 1, 0);
+    bits_[w] |= uint64_t(1) << (k % 64);
+    if (k == 0) Advance();
+    return true;
+  }
+
+  // @p seq is close enough to the watermark for Insert to record it
+  bool Accepts(uint64_t seq) const {
+    return seq <= acked_ || seq - acked_ - 1 < kMaxSeqGap;
+  }
+
+  /**
+   * @brief Moves the watermark to @p seq: the sequence numbers up to @p seq
+   *        that were not received are given up, e.g. because every holder
+   *        evicted them, and no longer count as missing.
+   */
+  void AdvanceTo(uint64_t seq) {
+    if (seq <= acked_) return;
+    uint64_t n = seq - acked_;
+    uint64_t received = 0;
+    for (size_t w = 0; w < bits_.size() && w * 64 < n; ++w) {
+      uint64_t word = bits_[w];
+      if (n - w * 64 < 64) word &= (uint64_t(1) << (n - w * 64)) - 1;
+      received += __builtin_popcountll(word);
+    }
+    // nothing past the head was received
+    if (head_ > acked_) missing_ -= std::min(seq, head_) - acked_ - received;
+    head_ = std::max(head_, seq);
+    Drop(n);
+    Advance();
+  }
+
+  // records that sequence numbers up to @p seq exist
+  void SetHead(uint64_t seq) {
+    if (seq <= head_) return;
+    missing_ += seq - head_;
+    head_ = seq;
+  }
+
+  uint64_t Head() const {
+    return head_;
+  }
+
+  // number of sequence numbers up to Head() that have not been received
+  uint64_t MissingNum() const {
+    return missing_;
+  }
+
+  /**
+   * @brief Calls @p f(lo, hi) for every maximal run [lo, hi] of missing
+   *        sequence numbers up to @p seq, in increasing order.
+   *
+   * The bitmap is scanned a word at a time, so the cost depends on the
+   * length of the out-of-order tail, not on the history.
+   */
+  template <typename F>
+  void ForEachMissing(uint64_t seq, F f) const {
+    if (seq <= acked_) return;
+    uint64_t n = seq - acked_;
+    uint64_t k = Find(0, false, n);
+    while (k < n) {
+      uint64_t end = Find(k, true, n);
+      f(acked_ + 1 + k, acked_ + end);
+      k = Find(end, false, n);
+    }
+  }
+
+  SeqNumIntervalSet CheckForMissingData(const uint64_t seq) const {
+    SeqNumIntervalSet r;
+    ForEachMissing(seq, [&r] (uint64_t lo, uint64_t hi) {
+      r.insert(SeqNumInterval::closed(lo, hi));
+    });
+    return r;
+  }
+
+  // the received sequence numbers form a single interval
+  bool HasAllData() const {
+    if (acked_ > 0) return bits_.empty();
+    if (bits_.empty()) return false;
+    uint64_t n = bits_.size() * 64;
+    uint64_t end = Find(Find(0, true, n), false, n);
+    return Find(end, true, n) == n;
+  }
+
+  bool HasAllDataBefore(uint64_t seq) const {
+    return acked_ > 0 && acked_ >= seq;
+  }
+
+  // every sequence number in [lo, hi] has been received
+  bool HasAllDataIn(uint64_t lo, uint64_t hi) const {
+    if (lo > hi) return true;
+    if (lo == 0) return false;
+    lo = std::max(lo, acked_ + 1);
+    if (lo > hi) return true;
+    return Find(lo - acked_ - 1, false, hi - acked_) == hi - acked_;
+  }
+
+  uint64_t LastAckedData() const {
+    return acked_;
+  }
+
+  bool HasData(uint64_t seq) const {
+    if (seq == 0) return false;
+    return seq <= acked_ || Test(seq - acked_ - 1);
+  }
+
+  SeqNumIntervalSet getWin() const {
+    SeqNumIntervalSet win;
+    if (acked_ > 0) win.insert(SeqNumInterval::closed(1, acked_));
+    uint64_t n = bits_.size() * 64;
+    uint64_t k = Find(0, true, n);
+    while (k < n) {
+      uint64_t end = Find(k, false, n);
+      win.insert(SeqNumInterval::closed(acked_ + 1 + k, acked_ + end));
+      k = Find(end, true, n);
+    }
+    return win;
+  }
+
+ private:
+  bool Test(uint64_t k) const {
+    return k / 64 < bits_.size() && (bits_[k / 64] >> (k % 64)) & 1;
+  }
+
+  // first bit position in [k, n) whose value is @p set, or n if there is none
+  uint64_t Find(uint64_t k, bool set, uint64_t n) const {
+    while (k < n) {
+      size_t w = k / 64;
+      if (w >= bits_.size()) return set ? n : k;
+      uint64_t word = set ? bits_[w] : ~bits_[w];
+      word &= ~uint64_t(0) << (k % 64);
+      if (word != 0) return std::min<uint64_t>(n, w * 64 + __builtin_ctzll(word));
+      k = (w + 1) * 64;
+    }
+    return n;
+  }
+
+  // moves the run of received sequence numbers at the start of the bitmap
+  // into the watermark
+  void Advance() {
+    size_t words = 0;
+    while (words < bits_.size() && bits_[words] == ~uint64_t(0)) words++;
+    unsigned ones = words < bits_.size() ? __builtin_ctzll(~bits_[words]) : 0;
+    Drop(64 * words + ones);
+  }
+
+  // moves the watermark @p n sequence numbers on, and the bitmap with it
+  void Drop(uint64_t n) {
+    acked_ += n;
+    size_t words = std::min<uint64_t>(n / 64, bits_.size());
+    unsigned shift = n % 64;
+    bits_.erase(bits_.begin(), bits_.begin() + words);
+    if (words < n / 64) bits_.clear();
+    if (shift > 0) {
+      for (size_t i = 0; i < bits_.size(); ++i) {
+        bits_[i] >>= shift;
+        if (i + 1 < bits_.size()) bits_[i] |= bits_[i + 1] << (64 - shift);
+      }
+    }
+    while (!bits_.empty() && bits_.back() == 0) bits_.pop_back();
+  }
+
+  uint64_t acked_ = 0;  // every sequence number in [1, acked_] was received
+  uint64_t head_ = 0;  // highest sequence number known to exist
+  uint64_t missing_ = 0;  // sequence numbers in (acked_, head_] not received
+  std::vector<uint64_t> bits_;
+};
+
+// One receive window per group member
+using ReceiveWindows = MemberVector<BitmapReceiveWindow, kInlineGroupSize>;
+
 }  // namespace vsync
 }  // namespace ndn
 
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "timer-wheel.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace vsync {
+
+const int TimerWheel::kLevelBits;
+const int TimerWheel::kLevels;
+const uint64_t TimerWheel::kSlots;
+const uint64_t TimerWheel::kNever;
+
+TimerWheel::Timer::Timer(TimerWheel& wheel, Callback cb)
+    : wheel_(wheel),
+      cb_(std::move(cb)),
+      expires_(0),
+      prev_(nullptr),
+      next_(nullptr),
+      slot_(nullptr) {
+}
+
+void TimerWheel::Timer::Arm(time::milliseconds delay) {
+  if (IsArmed()) wheel_.Unlink(this);
+  uint64_t ticks = delay.count() > 0 ? delay.count() : 0;
+  expires_ = std::max(wheel_.Now() + ticks, wheel_.current_ + 1);
+  wheel_.arm_num_++;
+  wheel_.Place(this);
+}
+
+void TimerWheel::Timer::Arm(time::milliseconds delay, Callback cb) {
+  cb_ = std::move(cb);
+  Arm(delay);
+}
+
+void TimerWheel::Timer::Cancel() {
+  // the wake-up of the wheel is left alone: it finds nothing to do
+  if (IsArmed()) wheel_.Unlink(this);
+}
+
+TimerWheel::TimerWheel()
+    : size_(0),
+      current_(0),
+      wake_(kNever),
+      advancing_(false),
+      arm_num_(0),
+      fired_num_(0) {
+  std::fill(&slots_[0][0], &slots_[0][0] + kLevels * kSlots, nullptr);
+  std::fill(level_size_, level_size_ + kLevels, 0);
+}
+
+void TimerWheel::Place(Timer* timer) {
+  uint64_t expires = timer->expires_;
+  int level = 0;
+  while (level < kLevels && expires - current_ >= uint64_t(1) << (kLevelBits * (level + 1))) level++;
+  if (level == kLevels) {
+    // beyond the top level: wait in its last slot
+    level = kLevels - 1;
+    expires = current_ + (uint64_t(1) << (kLevelBits * kLevels)) - 1;
+  }
+  int shift = kLevelBits * level;
+  Link(timer, &slots_[level][(expires >> shift) & (kSlots - 1)]);
+
+  // the slot is due, or moved down, at its first tick
+  uint64_t wake = level == 0 ? expires : (expires >> shift) << shift;
+  if (!advancing_ && wake < wake_) {
+    wake_ = wake;
+    OnWake(wake);
+  }
+}
+
+void TimerWheel::Link(Timer* timer, Timer** slot) {
+  timer->slot_ = slot;
+  timer->prev_ = nullptr;
+  timer->next_ = *slot;
+  if (*slot != nullptr) (*slot)->prev_ = timer;
+  *slot = timer;
+  level_size_[(slot - &slots_[0][0]) / kSlots]++;
+  size_++;
+}
+
+void TimerWheel::Unlink(Timer* timer) {
+  if (timer->prev_ != nullptr) timer->prev_->next_ = timer->next_;
+  else *timer->slot_ = timer->next_;
+  if (timer->next_ != nullptr) timer->next_->prev_ = timer->prev_;
+  level_size_[(timer->slot_ - &slots_[0][0]) / kSlots]--;
+  size_--;
+  timer->slot_ = nullptr;
+  timer->prev_ = timer->next_ = nullptr;
+}
+
+uint64_t TimerWheel::NextTick() const {
+  uint64_t next = kNever;
+  if (level_size_[0] > 0) {
+    for (uint64_t k = 1; k < kSlots; ++k) {
+      if (slots_[0][(current_ + k) & (kSlots - 1)] != nullptr) {
+        next = current_ + k;
+        break;
+      }
+    }
+  }
+  // the slots of the upper levels are moved down at their first tick
+  for (int level = 1; level < kLevels; ++level) {
+    if (level_size_[level] == 0) continue;
+    int shift = kLevelBits * level;
+    uint64_t first = ((current_ >> shift) + 1) << shift;
+    for (uint64_t k = 0; k < kSlots && first + (k << shift) < next; ++k) {
+      uint64_t tick = first + (k << shift);
+      if (slots_[level][(tick >> shift) & (kSlots - 1)] != nullptr) {
+        next = tick;
+        break;
+      }
+    }
+  }
+  return next;
+}
+
+void TimerWheel::Cascade(int level, uint64_t index) {
+  Timer* timer = slots_[level][index];
+  while (timer != nullptr) {
+    Timer* next = timer->next_;
+    Unlink(timer);
+    Place(timer);
+    timer = next;
+  }
+}
+
+void TimerWheel::Run(uint64_t tick) {
+  for (int level = 1; level < kLevels; ++level) {
+    int shift = kLevelBits * level;
+    if ((tick & ((uint64_t(1) << shift) - 1)) != 0) break;
+    Cascade(level, (tick >> shift) & (kSlots - 1));
+  }
+  // the callbacks may arm and cancel timers, their own included
+  Timer** slot = &slots_[0][tick & (kSlots - 1)];
+  while (*slot != nullptr) {
+    Timer* timer = *slot;
+    Unlink(timer);
+    if (timer->expires_ > tick) {
+      Place(timer);
+      continue;
+    }
+    fired_num_++;
+    // a copy, since the callback may arm its timer with another one; small
+    // callbacks are copied in place
+    Callback cb = timer->cb_;
+    if (cb) cb();
+  }
+}
+
+void TimerWheel::Advance(uint64_t tick) {
+  // the wake-up is set once, for what is left
+  advancing_ = true;
+  for (uint64_t next = NextTick(); next <= tick; next = NextTick()) {
+    current_ = next;
+    Run(next);
+  }
+  current_ = std::max(current_, tick);
+  advancing_ = false;
+  wake_ = NextTick();
+  OnWake(wake_);
+}
+
+SchedulerTimerWheel::SchedulerTimerWheel(Scheduler& scheduler)
+    : scheduler_(scheduler),
+      origin_(time::steady_clock::now()),
+      scheduler_event_num_(0) {
+}
+
+SchedulerTimerWheel::~SchedulerTimerWheel() {
+  scheduler_.cancelEvent(driver_);
+}
+
+time::nanoseconds SchedulerTimerWheel::Elapsed() const {
+  return time::duration_cast<time::nanoseconds>(time::steady_clock::now() - origin_);
+}
+
+// delays count from the next tick, so that no timer fires early
+uint64_t SchedulerTimerWheel::Now() const {
+  return (Elapsed().count() + 999999) / 1000000;
+}
+
+void SchedulerTimerWheel::OnWake(uint64_t tick) {
+  scheduler_.cancelEvent(driver_);
+  if (tick == kNever) return;
+  time::nanoseconds delay = time::milliseconds(tick) - Elapsed();
+  if (delay < time::nanoseconds(0)) delay = time::nanoseconds(0);
+  scheduler_event_num_++;
+  driver_ = scheduler_.scheduleEvent(delay, [this] { Advance(Elapsed().count() / 1000000); });
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_TIMER_WHEEL_HPP_
+#define NDN_VSYNC_TIMER_WHEEL_HPP_
+
+#include <functional>
+#include <limits>
+
+#include "ndn-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+/**
+ * Hierarchical timing wheel for the timers of one node.
+ *
+ * Node re-arms its interest timers on every overheard interest or data, and
+ * most of them are cancelled before they fire. On the Scheduler every re-arm
+ * is an erase from and an insert into one ordered event set shared by all the
+ * simulated nodes. Here a timer is an intrusive list node in a slot of the
+ * wheel: arming, re-arming and cancelling it is O(1) and never allocates,
+ * and the wheel keeps a single Scheduler event, for the earliest slot with
+ * something to do. Re-arming a timer to a later time does not touch that
+ * event at all.
+ *
+ * Ticks are milliseconds. The wheel has kLevels levels of kSlots slots: level
+ * l holds the timers due within kSlots^(l+1) ticks, in slots of kSlots^l
+ * ticks, and a slot of level l > 0 is moved down a level when its first tick
+ * comes. Timers further away than the top level wait in its last slot and
+ * are placed again when they reach it. A timer fires at the first tick at or
+ * after its due time, so up to one tick late and never early.
+ *
+ * The base class is driven by hand through Advance(); SchedulerTimerWheel
+ * drives it from a Scheduler.
+ */
+class TimerWheel {
+ public:
+  using Callback = std::function<void()>;
+
+  static const int kLevelBits = 6;
+  static const int kLevels = 4;
+  static const uint64_t kSlots = 1 << kLevelBits;
+  static const uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+  class Timer {
+   public:
+    explicit Timer(TimerWheel& wheel, Callback cb = nullptr);
+    ~Timer() { Cancel(); }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    // (re-)arms the timer @p delay from now, dropping the pending expiry
+    void Arm(time::milliseconds delay);
+    // the same with a new callback; one that only captures a pointer is
+    // stored in place, without allocation
+    void Arm(time::milliseconds delay, Callback cb);
+    void Cancel();
+    bool IsArmed() const { return slot_ != nullptr; }
+
+   private:
+    friend class TimerWheel;
+
+    TimerWheel& wheel_;
+    Callback cb_;
+    uint64_t expires_;
+    Timer* prev_;
+    Timer* next_;
+    Timer** slot_;  // head of the slot list, null when not armed
+  };
+
+  TimerWheel();
+  virtual ~TimerWheel() = default;
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // fires every timer due at or before @p tick, in order
+  void Advance(uint64_t tick);
+
+  // the first tick at which Advance() has something to do, kNever if none
+  uint64_t NextTick() const;
+
+  uint64_t CurrentTick() const { return current_; }
+  size_t Size() const { return size_; }
+
+  uint64_t GetArmNum() const { return arm_num_; }
+  uint64_t GetFiredNum() const { return fired_num_; }
+
+ protected:
+  // the tick that delays are counted from
+  virtual uint64_t Now() const { return current_; }
+  // NextTick() got earlier than the tick last notified, or Advance() ran
+  virtual void OnWake(uint64_t tick) {}
+
+ private:
+  void Place(Timer* timer);
+  void Link(Timer* timer, Timer** slot);
+  void Unlink(Timer* timer);
+  void Cascade(int level, uint64_t index);
+  void Run(uint64_t tick);
+
+ private:
+  Timer* slots_[kLevels][kSlots];
+  size_t level_size_[kLevels];
+  size_t size_;
+  uint64_t current_;
+  uint64_t wake_;  // tick last passed to OnWake(), kNever if none
+  bool advancing_;
+  uint64_t arm_num_;
+  uint64_t fired_num_;
+};
+
+/**
+ * A TimerWheel driven by @p scheduler, with ticks counted from its
+ * construction on the steady clock.
+ */
+class SchedulerTimerWheel : public TimerWheel {
+ public:
+  explicit SchedulerTimerWheel(Scheduler& scheduler);
+  ~SchedulerTimerWheel() override;
+
+  // Scheduler events used, against GetArmNum() timers armed
+  uint64_t GetSchedulerEventNum() const { return scheduler_event_num_; }
+
+ protected:
+  uint64_t Now() const override;
+  void OnWake(uint64_t tick) override;
+
+ private:
+  time::nanoseconds Elapsed() const;
+
+ private:
+  Scheduler& scheduler_;
+  time::steady_clock::time_point origin_;
+  EventId driver_;
+  uint64_t scheduler_event_num_;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_TIMER_WHEEL_HPP_
@@ -15,6 +15,7 @@
 #include <ndn-cxx/name.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include "member-vector.hpp"
 #include "vsync-message.pb.h"
 
 namespace ndn {
@@ -23,12 +24,25 @@ namespace vsync {
 // Type and constant declarations for VectorSync
 
 using NodeID = uint64_t;
-using VersionVector = std::vector<uint64_t>;
+
+// Groups of up to this many members keep their per-member state inline.
+// One size for every group: member-vector-bench shows no gain from an inline
+// capacity matched to groups of 32 to 128, where copying the whole array
+// costs as much as the allocation it saves.
+static const size_t kInlineGroupSize = 16;
+using VersionVector = MemberVector<uint64_t, kInlineGroupSize>;
 using GroupID = std::string;
 
+// Farthest a sequence number from the network may land past what a receiver
+// holds; beyond it the number is bogus and would only make the receiver
+// allocate for the gap
+static const uint64_t kMaxSeqGap = 1 << 16;
+
 static const Name kSyncPrefix = Name("/ndn/vsync");
 static const Name kSyncDataListPrefix = Name("/ndn/vsyncDatalist");
 static const Name kSyncDataPrefix = Name("/ndn/vsyncData");
+static const Name kSyncVVPrefix = Name("/ndn/vsyncVV");
+static const Name kSyncRepairPrefix = Name("/ndn/vsyncRepair");
 
 static const Name kProbePrefix = Name("/ndn/sleepingProbe");
 static const Name kProbeIntermediatePrefix = Name("/ndn/sleepingProbeIntermediate");
@@ -11,6 +11,7 @@
 #include <ndn-cxx/name.hpp>
 
 #include "vsync-common.hpp"
+#include "vv-kernels.hpp"
 
 namespace ndn {
 namespace vsync {
@@ -48,6 +49,201 @@ inline VersionVector DecodeVV(const std::string& vv_encode) {
   return vv;
 }
 
+// Binary version vector encoding: each entry is an unsigned LEB128 varint,
+// and the entries are concatenated into a single name component.
+static const size_t kMaxVarintSize = 10;
+
+inline size_t EncodeVarint(uint64_t value, uint8_t* out) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(value);
+  return n;
+}
+
+/**
+ * @brief   Decodes one varint from [@p begin, @p end).
+ *
+ * @return  Pointer past the decoded varint, or nullptr if the input is
+ *          truncated or the varint is longer than 64 bits.
+ */
+inline const uint8_t* DecodeVarint(const uint8_t* begin, const uint8_t* end, uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; begin != end && shift < 64; shift += 7) {
+    uint8_t b = *begin++;
+    value |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) return begin;
+  }
+  return nullptr;
+}
+
+inline name::Component EncodeVVBinary(const VersionVector& v) {
+  std::vector<uint8_t> buf(v.size() * kMaxVarintSize);
+  size_t len = 0;
+  for (auto seq: v) {
+    len += EncodeVarint(seq, buf.data() + len);
+  }
+  return name::Component(buf.data(), len);
+}
+
+/**
+ * @brief   Decodes a binary version vector straight into @p vv.
+ *
+ * @p vv is cleared first, so a caller that keeps the same vector around
+ * between calls does not allocate once its capacity reaches the group size.
+ *
+ * @return  false if @p buf is not a well-formed binary version vector.
+ */
+inline bool DecodeVVBinary(const uint8_t* buf, size_t buf_size, VersionVector& vv) {
+  vv.clear();
+  const uint8_t* end = buf + buf_size;
+  while (buf != end) {
+    uint64_t seq;
+    buf = DecodeVarint(buf, end, seq);
+    if (buf == nullptr) return false;
+    vv.push_back(seq);
+  }
+  return true;
+}
+
+inline bool DecodeVVBinary(const name::Component& c, VersionVector& vv) {
+  return DecodeVVBinary(c.value(), c.value_size(), vv);
+}
+
+// 32-bit FNV-1a digest of a version vector. Delta sync interests carry the
+// digest of their base vector so that responders can detect a stale base.
+inline uint32_t VVDigest(const VersionVector& v) {
+  uint32_t h = 2166136261u;
+  for (auto seq: v) {
+    for (int i = 0; i < 8; ++i) {
+      h ^= static_cast<uint8_t>(seq >> (8 * i));
+      h *= 16777619u;
+    }
+  }
+  return h;
+}
+
+/**
+ * @brief   Digest contribution of version vector entry @p index.
+ *
+ * The state digest of a node is the sum (mod 2^64) of the contributions of
+ * all its entries, so it can be updated in O(1) when a single entry changes.
+ */
+inline uint64_t VVEntryDigest(uint64_t index, uint64_t seq) {
+  // splitmix64 finalizer over the (index, seq) pair
+  uint64_t z = seq * 0x9e3779b97f4a7c15ull + index;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+inline uint64_t VVStateDigest(const VersionVector& v) {
+  uint64_t digest = 0;
+  for (size_t i = 0; i < v.size(); ++i) {
+    digest += VVEntryDigest(i, v[i]);
+  }
+  return digest;
+}
+
+/**
+ * @brief   Appends the entries of @p v that differ from @p base to @p buf as
+ *          (index, seq) varint pairs.
+ *
+ * @return  The number of pairs appended.
+ */
+inline size_t AppendVVDelta(const VersionVector& base, const VersionVector& v, std::vector<uint8_t>& buf) {
+  size_t len = buf.size();
+  size_t pairs = 0;
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (i < base.size() && base[i] == v[i]) continue;
+    buf.resize(len + 2 * kMaxVarintSize);
+    len += EncodeVarint(i, buf.data() + len);
+    len += EncodeVarint(v[i], buf.data() + len);
+    pairs++;
+  }
+  buf.resize(len);
+  return pairs;
+}
+
+/**
+ * @brief   Encodes the entries of @p v that differ from @p base as
+ *          (index, seq) varint pairs in a single name component.
+ */
+inline name::Component EncodeVVDelta(const VersionVector& base, const VersionVector& v) {
+  std::vector<uint8_t> buf;
+  AppendVVDelta(base, v, buf);
+  return name::Component(buf.data(), buf.size());
+}
+
+/**
+ * @brief   Applies a delta produced by EncodeVVDelta to @p vv in place.
+ *
+ * @return  false if the delta is malformed or refers to an index outside
+ *          of @p vv. @p vv may be partially updated in that case.
+ */
+inline bool ApplyVVDelta(const uint8_t* buf, size_t buf_size, VersionVector& vv) {
+  const uint8_t* end = buf + buf_size;
+  while (buf != end) {
+    uint64_t index, seq;
+    buf = DecodeVarint(buf, end, index);
+    if (buf == nullptr) return false;
+    buf = DecodeVarint(buf, end, seq);
+    if (buf == nullptr || index >= vv.size()) return false;
+    vv[index] = seq;
+  }
+  return true;
+}
+
+inline bool ApplyVVDelta(const name::Component& c, VersionVector& vv) {
+  return ApplyVVDelta(c.value(), c.value_size(), vv);
+}
+
+/**
+ * @brief   Encodes the garbage collection state carried by sync interests.
+ *
+ * Layout: varint(token_count) varint(number of token pairs) token pairs
+ * stable pairs, where both vectors are encoded as deltas against the
+ * sender's version vector @p vv.
+ */
+inline name::Component EncodeStabilityInfo(const VersionVector& vv, uint64_t token_count,
+                                           const VersionVector& token, const VersionVector& stable) {
+  std::vector<uint8_t> header(2 * kMaxVarintSize);
+  std::vector<uint8_t> token_pairs;
+  std::vector<uint8_t> stable_pairs;
+  size_t token_pair_num = AppendVVDelta(vv, token, token_pairs);
+  AppendVVDelta(vv, stable, stable_pairs);
+  size_t len = EncodeVarint(token_count, header.data());
+  len += EncodeVarint(token_pair_num, header.data() + len);
+  header.resize(len);
+  header.insert(header.end(), token_pairs.begin(), token_pairs.end());
+  header.insert(header.end(), stable_pairs.begin(), stable_pairs.end());
+  return name::Component(header.data(), header.size());
+}
+
+inline bool DecodeStabilityInfo(const name::Component& c, const VersionVector& vv, uint64_t& token_count,
+                                VersionVector& token, VersionVector& stable) {
+  const uint8_t* buf = c.value();
+  const uint8_t* end = buf + c.value_size();
+  uint64_t token_pair_num;
+  buf = DecodeVarint(buf, end, token_count);
+  if (buf == nullptr) return false;
+  buf = DecodeVarint(buf, end, token_pair_num);
+  if (buf == nullptr) return false;
+  token = vv;
+  stable = vv;
+  for (uint64_t i = 0; i < token_pair_num; ++i) {
+    uint64_t index, seq;
+    buf = DecodeVarint(buf, end, index);
+    if (buf == nullptr) return false;
+    buf = DecodeVarint(buf, end, seq);
+    if (buf == nullptr || index >= token.size()) return false;
+    token[index] = seq;
+  }
+  return ApplyVVDelta(buf, end - buf, stable);
+}
+
 /*
 inline void EncodeVV(const VersionVector& v, proto::VV* vv_proto) {
   for (const auto& seq: v) {
@@ -113,30 +309,86 @@ inline std::vector<std::pair<uint32_t, std::string>> DecodeDL(const void* buf, s
 struct VVCompare {
   bool operator()(const VersionVector& l, const VersionVector& r) const {
     if (l.size() != r.size()) return false;
-    size_t equal_count = 0;
-    auto lv = l.begin(), rv = r.begin();
-    while(lv != l.end()) { 
-      if(*lv > *rv) return false;
-      else if(*lv == *rv) equal_count ++;
-      lv = std::next(lv);
-      rv = std::next(rv);
-    }
-    if (equal_count == l.size())
-      return false;
-    else
-      return true;
+    return vv_kernels::GetCompare()(l.data(), r.data(), l.size()) == vv_kernels::kSomeLess;
   }
 };
 
 // Naming conventions for interests and data
 
-inline Name MakeSyncInterestName(const GroupID& gid, const NodeID& nid, const std::string& encoded_vv, const uint64_t sync_index) {
-  // name = /[vsync_prefix]/[group_id]/[sync_index]/[node_id]/[encoded_version_vector]
+inline Name MakeSyncInterestName(const GroupID& gid, const NodeID& nid, const std::string& encoded_vv, const uint64_t sync_index,
+                                 uint64_t state_digest = 0, const name::Component& stability_info = name::Component()) {
+  // name = /[vsync_prefix]/[group_id]/[state_digest]/[stability_info]/[sync_index]/[node_id]/[encoded_version_vector]
+  Name n(kSyncPrefix);
+  n.append(gid).appendNumber(state_digest).append(stability_info).appendNumber(sync_index).appendNumber(nid).append(encoded_vv);
+  return n;
+}
+
+inline Name MakeSyncInterestName(const GroupID& gid, const NodeID& nid, const name::Component& encoded_vv, const uint64_t sync_index,
+                                 uint64_t state_digest = 0, const name::Component& stability_info = name::Component()) {
+  // name = /[vsync_prefix]/[group_id]/[state_digest]/[stability_info]/[sync_index]/[node_id]/[binary_version_vector]
+  Name n(kSyncPrefix);
+  n.append(gid).appendNumber(state_digest).append(stability_info).appendNumber(sync_index).appendNumber(nid).append(encoded_vv);
+  return n;
+}
+
+// mark delta sync interests, and reconciliation sync interests and IBLT
+// requests, after the stability info; not valid number components, so they
+// cannot be mistaken for the sync index of a full version vector
+static const name::Component kDeltaMarker("delta");
+static const name::Component kIBLTMarker("ibf");
+
+inline Name MakeDeltaSyncInterestName(const GroupID& gid, const NodeID& nid, uint32_t base_digest, const name::Component& encoded_delta, const uint64_t sync_index,
+                                      uint64_t state_digest = 0, const name::Component& stability_info = name::Component()) {
+  // name = /[vsync_prefix]/[group_id]/[state_digest]/[stability_info]/delta/[base_digest]/[sync_index]/[node_id]/[encoded_delta]
   Name n(kSyncPrefix);
-  n.append(gid).appendNumber(sync_index).appendNumber(nid).append(encoded_vv);
+  n.append(gid).appendNumber(state_digest).append(stability_info).append(kDeltaMarker).appendNumber(base_digest);
+  n.appendNumber(sync_index).appendNumber(nid).append(encoded_delta);
   return n;
 }
 
+inline Name MakeIBLTSyncInterestName(const GroupID& gid, const NodeID& nid, const std::string& estimator, const uint64_t sync_index,
+                                     uint64_t state_digest = 0, const name::Component& stability_info = name::Component()) {
+  // name = /[vsync_prefix]/[group_id]/[state_digest]/[stability_info]/ibf/[sync_index]/[node_id]/[strata_estimator]
+  Name n(kSyncPrefix);
+  n.append(gid).appendNumber(state_digest).append(stability_info).append(kIBLTMarker).appendNumber(sync_index).appendNumber(nid);
+  n.append(reinterpret_cast<const uint8_t*>(estimator.data()), estimator.size());
+  return n;
+}
+
+inline bool IsIBLTSyncInterestName(const Name& n) {
+  return n.size() > kSyncPrefix.size() + 3 && n.get(kSyncPrefix.size() + 3) == kIBLTMarker;
+}
+
+inline bool IsDeltaSyncInterestName(const Name& n) {
+  return n.size() > kSyncPrefix.size() + 3 && n.get(kSyncPrefix.size() + 3) == kDeltaMarker;
+}
+
+inline Name MakeVVRequestName(const GroupID& gid, const NodeID& sync_requester, const uint64_t sync_index) {
+  // name = /[vsyncVV_prefix]/[group_id]/[sync_requester]/[sync_index]
+  Name n(kSyncVVPrefix);
+  n.append(gid).appendNumber(sync_requester).appendNumber(sync_index);
+  return n;
+}
+
+inline Name MakeIBLTRequestName(const GroupID& gid, const NodeID& sync_requester, const uint64_t sync_index, size_t cells) {
+  // name = /[vsyncVV_prefix]/[group_id]/[sync_requester]/[sync_index]/ibf/[cells]
+  Name n(kSyncVVPrefix);
+  n.append(gid).appendNumber(sync_requester).appendNumber(sync_index).append(kIBLTMarker).appendNumber(cells);
+  return n;
+}
+
+inline bool ParseIBLTRequestName(const Name& n, NodeID& sync_requester, uint64_t& sync_index, size_t& cells) {
+  if (n.size() != kSyncVVPrefix.size() + 5 || n.get(-2) != kIBLTMarker) return false;
+  const auto& requester = n.get(-4);
+  const auto& index = n.get(-3);
+  const auto& num = n.get(-1);
+  if (!requester.isNumber() || !index.isNumber() || !num.isNumber()) return false;
+  sync_requester = requester.toNumber();
+  sync_index = index.toNumber();
+  cells = num.toNumber();
+  return true;
+}
+
 inline Name MakeProbeIntermediateInterestName(const GroupID& gid) {
   Name n(kProbeIntermediatePrefix);
   n.append(gid).appendNumber(0).appendNumber(0);
@@ -165,14 +417,25 @@ inline Name MakeSleepCommandName(const GroupID& gid, const NodeID& nid) {
   return n;
 }
 
-inline Name MakeSyncACKInterestName(const GroupID& gid, const NodeID& sync_requester, const NodeID& sync_responder, const uint64_t sync_index, const size_t pending_list_size) {
-  // name = /[sync_ack_interest_prefix]/[group_id]/[sync_responder]/[sign = node + timestamp]
+inline Name MakeSyncACKInterestName(const GroupID& gid, const NodeID& sync_requester, const NodeID& sync_responder, const uint64_t sync_index, const size_t pending_list_size,
+                                     const name::Component& sync_reply_request = name::Component()) {
+  // name = /[sync_ack_interest_prefix]/[group_id]/[sync_responder]/[sign = node + timestamp]([sync_reply_request])
   std::string sign = to_string(sync_responder) + "-" + to_string(sync_index) + "-" + to_string(pending_list_size);
   Name n(kSyncACKPrefix);
   n.append(gid).appendNumber(sync_requester).append(sign);
+  if (!sync_reply_request.empty()) n.append(sync_reply_request);
   return n;
 }
 
+/**
+ * @brief   Encodes the data a sync-responder asks to get with the reply to
+ *          its SyncACK: everything from sequence number @p from[p] on for
+ *          every producer p with a non-zero entry.
+ */
+inline name::Component EncodeSyncReplyRequest(const VersionVector& from) {
+  return EncodeVVDelta(VersionVector(from.size(), 0), from);
+}
+
 inline Name MakeDataName(const GroupID& gid, const NodeID& nid, uint64_t seq) {
   // name = /[vsyncData_prefix]/[group_id]/[node_id]/[seq]
   Name n(kSyncDataPrefix);
@@ -180,6 +443,71 @@ inline Name MakeDataName(const GroupID& gid, const NodeID& nid, uint64_t seq) {
   return n;
 }
 
+inline Name MakeDataListName(const GroupID& gid, const NodeID& nid, uint64_t lo, uint64_t hi) {
+  // name = /[vsyncDatalist_prefix]/[group_id]/[node_id]/[lo]/[hi]
+  Name n(kSyncDataListPrefix);
+  n.append(gid).appendNumber(nid).appendNumber(lo).appendNumber(hi);
+  return n;
+}
+
+inline Name MakePushInterestName(const GroupID& gid) {
+  // name = /[vsyncDatalist_prefix]/[group_id]/push
+  Name n(kSyncDataListPrefix);
+  n.append(gid).append("push");
+  return n;
+}
+
+inline Name MakePushDataName(const GroupID& gid, const NodeID& nid, uint64_t lo, uint64_t hi) {
+  // name = /[vsyncDatalist_prefix]/[group_id]/push/[node_id]/[lo]/[hi]
+  return MakePushInterestName(gid).appendNumber(nid).appendNumber(lo).appendNumber(hi);
+}
+
+// true for the push interest and the pushed data list names
+inline bool IsPushName(const Name& n) {
+  return n.size() > kSyncDataListPrefix.size() + 1 && kSyncDataListPrefix.isPrefixOf(n) &&
+         n.get(kSyncDataListPrefix.size() + 1) == name::Component("push");
+}
+
+inline Name MakeRepairRequestName(const GroupID& gid, const NodeID& sync_requester, const uint64_t sync_index,
+                                  const NodeID& sync_responder, const std::string& items) {
+  // name = /[vsyncRepair_prefix]/[group_id]/[sync_requester]/[sync_index]/request/[sync_responder]/[items]
+  Name n(kSyncRepairPrefix);
+  n.append(gid).appendNumber(sync_requester).appendNumber(sync_index).append("request").appendNumber(sync_responder)
+   .append(reinterpret_cast<const uint8_t*>(items.data()), items.size());
+  return n;
+}
+
+inline Name MakeRepairInterestName(const GroupID& gid, const NodeID& sync_requester, const uint64_t sync_index,
+                                   uint64_t k) {
+  // name = /[vsyncRepair_prefix]/[group_id]/[sync_requester]/[sync_index]/[k]
+  Name n(kSyncRepairPrefix);
+  n.append(gid).appendNumber(sync_requester).appendNumber(sync_index).appendNumber(k);
+  return n;
+}
+
+/**
+ * @brief   Reads a repair request name or the name of coded packet k of a
+ *          repair round (see MakeRepairRequestName and MakeRepairInterestName).
+ *          The item list of a request is its last component.
+ */
+inline bool ParseRepairName(const Name& n, NodeID& sync_requester, uint64_t& sync_index, bool& is_request) {
+  const size_t base = kSyncRepairPrefix.size();
+  if (!kSyncRepairPrefix.isPrefixOf(n)) return false;
+  if (n.size() == base + 4) {
+    is_request = false;
+    if (!n.get(base + 3).isNumber()) return false;
+  }
+  else if (n.size() == base + 6 && n.get(base + 3) == name::Component("request")) {
+    is_request = true;
+    if (!n.get(base + 4).isNumber()) return false;
+  }
+  else return false;
+  if (!n.get(base + 1).isNumber() || !n.get(base + 2).isNumber()) return false;
+  sync_requester = n.get(base + 1).toNumber();
+  sync_index = n.get(base + 2).toNumber();
+  return true;
+}
+
 // helper functions for extracting name components
 inline uint64_t ExtractSyncIndex(const Name& n) {
   return n.get(-3).toNumber();
@@ -198,8 +526,103 @@ inline std::string ExtractEncodedVV(const Name& n) {
   return n.get(-1).toUri();
 }
 
+inline const name::Component& ExtractEncodedVVComponent(const Name& n) {
+  return n.get(-1);
+}
+
+inline uint64_t ExtractStateDigest(const Name& n) {
+  return n.get(kSyncPrefix.size() + 1).toNumber();
+}
+
+inline const name::Component& ExtractStabilityInfo(const Name& n) {
+  return n.get(kSyncPrefix.size() + 2);
+}
+
+inline uint32_t ExtractBaseDigest(const Name& n) {
+  return static_cast<uint32_t>(n.get(-4).toNumber());
+}
+
+// whether @p c reads [sync_responder]-[sync_index]-[pending_list_size]
+inline bool IsSyncACKSign(const name::Component& c) {
+  int dashes = 0;
+  bool digits = false;
+  for (size_t i = 0; i < c.value_size(); ++i) {
+    uint8_t b = c.value()[i];
+    if (b == '-') {
+      if (!digits) return false;
+      dashes++;
+      digits = false;
+    }
+    else if (b >= '0' && b <= '9') digits = true;
+    else return false;
+  }
+  return dashes == 2 && digits;
+}
+
+/**
+ * @brief   Position from the end of the sign of a SyncACK name, or of the
+ *          /[incomingSyncACK_prefix] notification of one, 0 if there is none.
+ *
+ * Both end with /[group_id]/[sync_requester]/[sign]([sync_reply_request]),
+ * whatever comes before, so the SyncACK helpers parse them from the end.
+ */
+inline ssize_t SyncACKSignPosition(const Name& n) {
+  if (n.size() >= 3 && IsSyncACKSign(n.get(-1))) return -1;
+  if (n.size() >= 4 && IsSyncACKSign(n.get(-2))) return -2;
+  return 0;
+}
+
+inline NodeID ExtractSyncACKRequester(const Name& n) {
+  return n.get(SyncACKSignPosition(n) - 1).toNumber();
+}
+
 inline std::string ExtractSyncACKSign(const Name& n) {
-  return n.get(-1).toUri();
+  return n.get(SyncACKSignPosition(n)).toUri();
+}
+
+/**
+ * @brief   Reads group ID, sync-requester and the sign of a SyncACK name, or
+ *          of the notification of one, without throwing on a malformed name.
+ *
+ * @return  false if the name has no sign or the requester is not a number.
+ */
+inline bool ParseSyncACKName(const Name& n, name::Component& gid, NodeID& sync_requester,
+                             NodeID& sync_responder, uint64_t& sync_index, uint64_t& pending_list_size) {
+  ssize_t pos = SyncACKSignPosition(n);
+  if (pos == 0 || !n.get(pos - 1).isNumber()) return false;
+  gid = n.get(pos - 2);
+  sync_requester = n.get(pos - 1).toNumber();
+  uint64_t fields[3] = {0, 0, 0};
+  const auto& sign = n.get(pos);
+  for (size_t i = 0, k = 0; i < sign.value_size(); ++i) {
+    uint8_t b = sign.value()[i];
+    if (b == '-') k++;
+    else fields[k] = fields[k] * 10 + (b - '0');
+  }
+  sync_responder = fields[0];
+  sync_index = fields[1];
+  pending_list_size = fields[2];
+  return true;
+}
+
+// the same, for callers that do not use the pending list size
+inline bool ParseSyncACKName(const Name& n, name::Component& gid, NodeID& sync_requester,
+                             NodeID& sync_responder, uint64_t& sync_index) {
+  uint64_t pending_list_size;
+  return ParseSyncACKName(n, gid, sync_requester, sync_responder, sync_index, pending_list_size);
+}
+
+/**
+ * @brief   Decodes the sync reply request of a SyncACK name into @p from,
+ *          which must have the size of the group.
+ *
+ * @return  false if the request is malformed; @p from is all zero if the
+ *          name carries no request.
+ */
+inline bool ExtractSyncReplyRequest(const Name& n, VersionVector& from) {
+  std::fill(from.begin(), from.end(), 0);
+  if (SyncACKSignPosition(n) != -2) return true;
+  return ApplyVVDelta(n.get(-1), from);
 }
 
 inline uint64_t ExtractSleepingTime(const Name& n) {
@@ -210,6 +633,45 @@ inline uint64_t ExtractSequence(const Name& n) {
   return n.get(-1).toNumber();
 }
 
+/**
+ * @brief   Reads node ID and sequence number of a data name
+ *          /[vsyncData_prefix]/[group_id]/[node_id]/[seq] in place.
+ *
+ * @return  false if @p n is not a data name.
+ */
+inline bool ParseDataName(const Name& n, NodeID& nid, uint64_t& seq) {
+  if (n.size() != kSyncDataPrefix.size() + 3 || !kSyncDataPrefix.isPrefixOf(n)) return false;
+  const auto& nid_component = n.get(-2);
+  const auto& seq_component = n.get(-1);
+  if (!nid_component.isNumber() || !seq_component.isNumber()) return false;
+  nid = nid_component.toNumber();
+  seq = seq_component.toNumber();
+  return true;
+}
+
+/**
+ * @brief   Reads node ID and sequence number range of a data list interest
+ *          name /[vsyncDatalist_prefix]/[group_id]/[node_id]/[lo]/[hi], or
+ *          of the name of its reply, which also carries the last sequence
+ *          number in the bundle: /[...]/[hi]/[last].
+ *
+ * @return  false if @p n is not a data list name (pushed data lists are
+ *          not) or the range is empty.
+ */
+inline bool ParseDataListName(const Name& n, NodeID& nid, uint64_t& lo, uint64_t& hi) {
+  size_t size = kSyncDataListPrefix.size() + 4;
+  if ((n.size() != size && n.size() != size + 1) || !kSyncDataListPrefix.isPrefixOf(n)) return false;
+  // "push" would pass as a 4-byte number
+  if (IsPushName(n)) return false;
+  for (size_t i = kSyncDataListPrefix.size() + 1; i < n.size(); ++i) {
+    if (!n.get(i).isNumber()) return false;
+  }
+  nid = n.get(kSyncDataListPrefix.size() + 1).toNumber();
+  lo = n.get(kSyncDataListPrefix.size() + 2).toNumber();
+  hi = n.get(kSyncDataListPrefix.size() + 3).toNumber();
+  return lo <= hi;
+}
+
 }  // namespace vsync
 }  // namespace ndn
 
@@ -4,5 +4,7 @@
 #define NDN_VSYNC_HPP_
 
 #include "node.hpp"
+#include "device.hpp"
+#include "cluster.hpp"
 
 #endif  // NDN_VSYNC_HPP_
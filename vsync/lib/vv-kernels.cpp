@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include "vv-kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VSYNC_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ndn {
+namespace vsync {
+namespace vv_kernels {
+
+void MergeScalar(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = l[i] > r[i] ? l[i] : r[i];
+  }
+}
+
+unsigned CompareScalar(const uint64_t* l, const uint64_t* r, size_t n) {
+  unsigned flags = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (l[i] > r[i]) flags |= kSomeGreater;
+    else if (l[i] < r[i]) flags |= kSomeLess;
+    if (flags == (kSomeGreater | kSomeLess)) break;
+  }
+  return flags;
+}
+
+#ifdef VSYNC_HAVE_X86
+
+// AVX2 has no unsigned 64-bit compare, so both operands are shifted into the
+// signed range by flipping the sign bit before _mm256_cmpgt_epi64.
+
+__attribute__((target("avx2")))
+void MergeAVX2(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n) {
+  const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(0x8000000000000000ull));
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_blendv_epi8(b, a, gt));
+  }
+  MergeScalar(out + i, l + i, r + i, n - i);
+}
+
+__attribute__((target("avx2")))
+unsigned CompareAVX2(const uint64_t* l, const uint64_t* r, size_t n) {
+  const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(0x8000000000000000ull));
+  __m256i any_gt = _mm256_setzero_si256();
+  __m256i any_lt = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i)), sign);
+    __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i)), sign);
+    any_gt = _mm256_or_si256(any_gt, _mm256_cmpgt_epi64(a, b));
+    any_lt = _mm256_or_si256(any_lt, _mm256_cmpgt_epi64(b, a));
+    // stop early once the vectors are known to be concurrent
+    if ((i & 63) == 60 && !_mm256_testz_si256(any_gt, any_gt) && !_mm256_testz_si256(any_lt, any_lt)) {
+      return kSomeGreater | kSomeLess;
+    }
+  }
+  unsigned flags = CompareScalar(l + i, r + i, n - i);
+  if (!_mm256_testz_si256(any_gt, any_gt)) flags |= kSomeGreater;
+  if (!_mm256_testz_si256(any_lt, any_lt)) flags |= kSomeLess;
+  return flags;
+}
+
+bool HasAVX2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+#else
+
+void MergeAVX2(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n) {
+  MergeScalar(out, l, r, n);
+}
+
+unsigned CompareAVX2(const uint64_t* l, const uint64_t* r, size_t n) {
+  return CompareScalar(l, r, n);
+}
+
+bool HasAVX2() {
+  return false;
+}
+
+#endif  // VSYNC_HAVE_X86
+
+MergeFn GetMerge() {
+  static const MergeFn merge = HasAVX2() ? MergeAVX2 : MergeScalar;
+  return merge;
+}
+
+CompareFn GetCompare() {
+  static const CompareFn compare = HasAVX2() ? CompareAVX2 : CompareScalar;
+  return compare;
+}
+
+}  // namespace vv_kernels
+
+VersionVector Merge(const VersionVector& l, const VersionVector& r) {
+  if (l.size() != r.size()) return VersionVector();
+  VersionVector out(l.size());
+  vv_kernels::GetMerge()(out.data(), l.data(), r.data(), l.size());
+  return out;
+}
+
+bool MergeInto(VersionVector& l, const VersionVector& r) {
+  if (l.size() != r.size()) return false;
+  vv_kernels::GetMerge()(l.data(), l.data(), r.data(), l.size());
+  return true;
+}
+
+bool Dominates(const VersionVector& l, const VersionVector& r) {
+  if (l.size() != r.size()) return false;
+  return (vv_kernels::GetCompare()(l.data(), r.data(), l.size()) & vv_kernels::kSomeLess) == 0;
+}
+
+bool Concurrent(const VersionVector& l, const VersionVector& r) {
+  if (l.size() != r.size()) return false;
+  return vv_kernels::GetCompare()(l.data(), r.data(), l.size()) ==
+         (vv_kernels::kSomeGreater | vv_kernels::kSomeLess);
+}
+
+bool Equal(const VersionVector& l, const VersionVector& r) {
+  if (l.size() != r.size()) return false;
+  return vv_kernels::GetCompare()(l.data(), r.data(), l.size()) == 0;
+}
+
+}  // namespace vsync
+}  // namespace ndn
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_VV_KERNELS_HPP_
+#define NDN_VSYNC_VV_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "vsync-common.hpp"
+
+namespace ndn {
+namespace vsync {
+
+// Element-wise kernels over raw version vector entries. Each kernel has a
+// portable scalar version and an AVX2 version; the Merge/Dominates/...
+// functions below pick the AVX2 one at runtime when the CPU supports it.
+namespace vv_kernels {
+
+// Flags returned by the compare kernels
+enum CompareFlags : unsigned {
+  kSomeGreater = 1,  // l[i] > r[i] for some i
+  kSomeLess = 2,     // l[i] < r[i] for some i
+};
+
+using MergeFn = void (*)(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n);
+using CompareFn = unsigned (*)(const uint64_t* l, const uint64_t* r, size_t n);
+
+void MergeScalar(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n);
+unsigned CompareScalar(const uint64_t* l, const uint64_t* r, size_t n);
+
+// Only call these when HasAVX2() returns true.
+void MergeAVX2(uint64_t* out, const uint64_t* l, const uint64_t* r, size_t n);
+unsigned CompareAVX2(const uint64_t* l, const uint64_t* r, size_t n);
+
+bool HasAVX2();
+
+// Kernels selected for this CPU
+MergeFn GetMerge();
+CompareFn GetCompare();
+
+}  // namespace vv_kernels
+
+/**
+ * @brief   Returns the element-wise maximum of @p l and @p r, or an empty
+ *          vector if their sizes differ.
+ */
+VersionVector Merge(const VersionVector& l, const VersionVector& r);
+
+/**
+ * @brief   Merges @p r into @p l in place.
+ *
+ * @return  false (leaving @p l untouched) if the sizes differ.
+ */
+bool MergeInto(VersionVector& l, const VersionVector& r);
+
+// l[i] >= r[i] for every i
+bool Dominates(const VersionVector& l, const VersionVector& r);
+
+// neither vector dominates the other
+bool Concurrent(const VersionVector& l, const VersionVector& r);
+
+bool Equal(const VersionVector& l, const VersionVector& r);
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_VV_KERNELS_HPP_
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "adaptive-timer.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestAdaptiveTimer);
+
+using namespace ndn::vsync;
+
+static AdaptiveTimer::Slot MakeSlot(uint64_t sent, uint64_t collisions, uint64_t suppressions,
+                                    uint64_t responders) {
+  return AdaptiveTimer::Slot{sent, collisions, 0, suppressions, responders};
+}
+
+BOOST_AUTO_TEST_CASE(Initial) {
+  AdaptiveTimer timer(20);
+  BOOST_CHECK_EQUAL(timer.DT(), 20);
+  // the timers of the fixed configuration
+  BOOST_CHECK_EQUAL(timer.WT(), 23);
+  BOOST_CHECK_EQUAL(timer.PitLifetime(), 54);
+  BOOST_CHECK_EQUAL(AdaptiveTimer(1000).DT(), AdaptiveTimer::kMaxDT);
+
+  // nothing seen: nothing learned
+  timer.OnSlot(MakeSlot(0, 0, 0, 0));
+  BOOST_CHECK_EQUAL(timer.SlotNum(), 0U);
+  BOOST_CHECK_EQUAL(timer.DT(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(GrowsUnderContention) {
+  AdaptiveTimer timer(10);
+  double dt = timer.DT();
+  for (int i = 0; i < 3; ++i) {
+    timer.OnSlot(MakeSlot(4, 4, 0, 2));
+    BOOST_CHECK_GT(timer.DT(), dt);
+    dt = timer.DT();
+  }
+  for (int i = 0; i < 20; ++i) timer.OnSlot(MakeSlot(4, 4, 0, 2));
+  BOOST_CHECK_EQUAL(timer.DT(), AdaptiveTimer::kMaxDT);
+  BOOST_CHECK_GT(timer.LossRate(), AdaptiveTimer::kHighLoss);
+}
+
+BOOST_AUTO_TEST_CASE(ShrinksWhenQuiet) {
+  AdaptiveTimer timer(20);
+  for (int i = 0; i < 50; ++i) timer.OnSlot(MakeSlot(4, 0, 0, 1));
+  BOOST_CHECK_EQUAL(timer.DT(), AdaptiveTimer::kMinDT);
+
+  // suppressed interests hold the window
+  AdaptiveTimer held(20);
+  for (int i = 0; i < 50; ++i) held.OnSlot(MakeSlot(4, 0, 2, 1));
+  BOOST_CHECK_EQUAL(held.DT(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(RespondersBoundWindow) {
+  // 10 responders need at least 10 transmission times, loss or not
+  AdaptiveTimer timer(5, 3);
+  for (int i = 0; i < 50; ++i) timer.OnSlot(MakeSlot(1, 0, 0, 10));
+  BOOST_CHECK_CLOSE(timer.Responders(), 10, 1);
+  BOOST_CHECK_GE(timer.DT(), 29);
+  BOOST_CHECK_LE(timer.DT(), 30);
+}
+
+BOOST_AUTO_TEST_CASE(Converges) {
+  // the loss rate falls as the window grows; the window settles
+  AdaptiveTimer timer(5);
+  std::vector<double> dts;
+  for (int i = 0; i < 200; ++i) {
+    uint64_t collisions = timer.DT() < 30 ? 2 : 0;
+    timer.OnSlot(MakeSlot(4, collisions, 0, 3));
+    dts.push_back(timer.DT());
+  }
+  for (size_t i = 150; i < dts.size(); ++i) {
+    BOOST_CHECK_GE(dts[i], 20);
+    BOOST_CHECK_LE(dts[i], AdaptiveTimer::kMaxDT);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
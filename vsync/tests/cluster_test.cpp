@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "cluster.hpp"
+#include "device-fixture.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestCluster);
+
+using namespace ndn::vsync;
+
+BOOST_AUTO_TEST_CASE(GroupIDs) {
+  BOOST_CHECK_EQUAL(MakeClusterGroupID("group0", 3), "group0-c3");
+  BOOST_CHECK_EQUAL(MakeBackboneGroupID("group0"), "group0-backbone");
+  // every cluster and the backbone are groups of their own
+  BOOST_CHECK(MakeClusterGroupID("group0", 1) != MakeClusterGroupID("group0", 11));
+  BOOST_CHECK(MakeBackboneGroupID("group0") != MakeClusterGroupID("group0", 0));
+}
+
+BOOST_AUTO_TEST_CASE(Unwrap) {
+  ndn::Data data(MakeDataName("group0-c1", 0, 1));
+  const std::string content = "Hello from 0";
+  data.setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  // only relayed objects carry another Data
+  BOOST_CHECK(UnwrapRelayedData(data) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(RelayRoundTrip, DeviceFixture) {
+  Node node(device, 0, ndn::Name("/"), MakeBackboneGroupID("group0"), 4, [] (const VersionVector&) {});
+  std::shared_ptr<const ndn::Data> relayed;
+  node.SetNewDataCallback([&relayed] (NodeID, uint64_t, const ndn::Data& data) {
+    relayed = data.shared_from_this();
+  });
+
+  const std::string content = "Hello from 2";
+  auto original = MakeSignedData(MakeClusterGroupID("group0", 1), 2, 5, content);
+  const ndn::Block& wire = original->wireEncode();
+  node.PublishRelayed(wire.wire(), wire.size());
+
+  BOOST_REQUIRE(relayed != nullptr);
+  BOOST_CHECK_EQUAL(relayed->getContentType(), Node::kRelayedData);
+  auto unwrapped = UnwrapRelayedData(*relayed);
+  BOOST_REQUIRE(unwrapped != nullptr);
+  BOOST_CHECK_EQUAL(unwrapped->getName(), original->getName());
+  const auto& unwrapped_content = unwrapped->getContent();
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(unwrapped_content.value()),
+                                unwrapped_content.value_size()), content);
+}
+
+BOOST_FIXTURE_TEST_CASE(HeadRelaysOnce, DeviceFixture) {
+  ClusterHead head(device, ndn::Name("/"), "group0", 1, 3, 0, 4);
+
+  // an object of the cluster goes up to the backbone, and the head does not
+  // bring its own relay back down
+  head.GetClusterNode().PublishData("Hello from 0");
+  BOOST_CHECK_EQUAL(head.GetRelayedUpNum(), 1U);
+  BOOST_CHECK_EQUAL(head.GetRelayedDownNum(), 0U);
+
+  // an object relayed into the cluster came from the backbone: it does not
+  // go back up
+  auto other = MakeSignedData(MakeClusterGroupID("group0", 2), 1, 1);
+  const ndn::Block& wire = other->wireEncode();
+  head.GetClusterNode().PublishRelayed(wire.wire(), wire.size());
+  BOOST_CHECK_EQUAL(head.GetRelayedUpNum(), 1U);
+  BOOST_CHECK_EQUAL(head.GetRelayedDownNum(), 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "data-log.hpp"
+#include "vsync-helper.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestDataLog);
+
+using namespace ndn::vsync;
+
+static std::string MakeTempDir() {
+  char dir[] = "/tmp/vsync-data-log-XXXXXX";
+  BOOST_REQUIRE(mkdtemp(dir) != nullptr);
+  return dir;
+}
+
+static void RemoveDir(const std::string& dir) {
+  DIR* d = opendir(dir.c_str());
+  BOOST_REQUIRE(d != nullptr);
+  while (struct dirent* entry = readdir(d)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") BOOST_CHECK_EQUAL(unlink((dir + "/" + name).c_str()), 0);
+  }
+  closedir(d);
+  BOOST_CHECK_EQUAL(rmdir(dir.c_str()), 0);
+}
+
+static ndn::Block MakeWire(NodeID nid, uint64_t seq, uint32_t content_type = 0) {
+  static ndn::KeyChain key_chain;
+  ndn::Data data(MakeDataName("group0", nid, seq));
+  data.setContentType(content_type);
+  const std::string content = "Hello from " + std::to_string(nid) + " #" + std::to_string(seq);
+  data.setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  key_chain.sign(data, ndn::signingWithSha256());
+  return data.wireEncode();
+}
+
+BOOST_AUTO_TEST_CASE(AppendAndRecover) {
+  auto dir = MakeTempDir();
+  // small segments so that the log spans several of them
+  const size_t segment_size = 4096;
+  {
+    DataLog log(dir, segment_size);
+    BOOST_CHECK_EQUAL(log.Size(), 0U);
+    for (uint64_t seq = 1; seq <= 100; ++seq) {
+      BOOST_CHECK(log.Append(seq % 3, seq, MakeWire(seq % 3, seq, seq % 2), seq % 2));
+    }
+    BOOST_CHECK(!log.Append(1, 1, MakeWire(1, 1)));
+    BOOST_CHECK(!log.Append(1, 0, MakeWire(1, 0)));
+    BOOST_CHECK_EQUAL(log.Size(), 100U);
+    BOOST_CHECK(log.SegmentNum() > 1);
+
+    auto wire = MakeWire(2, 5, 1);
+    uint32_t type = 0;
+    auto found = log.Find(2, 5, type);
+    BOOST_REQUIRE(found.first != nullptr);
+    BOOST_CHECK_EQUAL(type, 1U);
+    BOOST_CHECK_EQUAL(found.second, wire.size());
+    BOOST_CHECK(std::memcmp(found.first, wire.wire(), wire.size()) == 0);
+    BOOST_CHECK(!log.Has(0, 5));
+    log.Sync();
+  }
+
+  // reopening rebuilds the index by scanning the segments
+  DataLog log(dir, segment_size);
+  BOOST_CHECK_EQUAL(log.Size(), 100U);
+  size_t n = 0;
+  log.ForEach([&n] (NodeID nid, uint64_t seq) {
+    BOOST_CHECK_EQUAL(nid, seq % 3);
+    n++;
+  });
+  BOOST_CHECK_EQUAL(n, 100U);
+  auto wire = MakeWire(1, 100, 0);
+  uint32_t type = 1;
+  auto found = log.Find(1, 100, type);
+  BOOST_REQUIRE(found.first != nullptr);
+  BOOST_CHECK(std::memcmp(found.first, wire.wire(), wire.size()) == 0);
+  // the content types come back from the record headers
+  BOOST_CHECK_EQUAL(type, 0U);
+  BOOST_CHECK(log.Find(1, 97, type).first != nullptr);
+  BOOST_CHECK_EQUAL(type, 1U);
+
+  // appends continue after the recovered records
+  BOOST_CHECK(log.Append(0, 101, MakeWire(0, 101)));
+  BOOST_CHECK(log.Has(0, 101));
+
+  RemoveDir(dir);
+}
+
+BOOST_AUTO_TEST_CASE(ReopenWithSmallerSegments) {
+  auto dir = MakeTempDir();
+  {
+    DataLog log(dir, 64 * 1024);
+    for (uint64_t seq = 1; seq <= 100; ++seq) BOOST_CHECK(log.Append(0, seq, MakeWire(0, seq)));
+    BOOST_CHECK_EQUAL(log.SegmentNum(), 1U);
+  }
+  // the segment keeps the size it was written with
+  {
+    DataLog log(dir, 4096);
+    BOOST_CHECK_EQUAL(log.Size(), 100U);
+    auto wire = MakeWire(0, 100);
+    auto found = log.Find(0, 100);
+    BOOST_REQUIRE(found.first != nullptr);
+    BOOST_CHECK(std::memcmp(found.first, wire.wire(), wire.size()) == 0);
+    BOOST_CHECK(log.Append(0, 101, MakeWire(0, 101)));
+  }
+  DataLog log(dir, 4096);
+  BOOST_CHECK_EQUAL(log.Size(), 101U);
+  RemoveDir(dir);
+}
+
+BOOST_AUTO_TEST_CASE(Reclaim) {
+  auto dir = MakeTempDir();
+  const size_t segment_size = 1024;
+  {
+    DataLog log(dir, segment_size);
+    for (uint64_t seq = 1; seq <= 100; ++seq) BOOST_CHECK(log.Append(seq % 2, seq, MakeWire(seq % 2, seq)));
+    size_t segments = log.SegmentNum();
+    BOOST_REQUIRE(segments > 3);
+
+    // one producer past its horizon is not enough to free a segment
+    BOOST_CHECK_EQUAL(log.Reclaim([] (NodeID nid) { return nid == 0 ? 101 : 1; }), 0U);
+    BOOST_CHECK_EQUAL(log.Size(), 100U);
+
+    // the first half of both producers
+    BOOST_CHECK(log.Reclaim([] (NodeID) { return 51; }) > 0);
+    BOOST_CHECK(log.SegmentNum() < segments);
+    BOOST_CHECK(log.Size() < 100U);
+    BOOST_CHECK(!log.Has(1, 1));
+    BOOST_CHECK(log.Has(0, 100));
+
+    // the segment being appended to stays
+    BOOST_CHECK(log.Reclaim([] (NodeID) { return 1000; }) > 0);
+    BOOST_CHECK_EQUAL(log.SegmentNum(), 1U);
+    BOOST_CHECK(log.Has(0, 100));
+  }
+  // the numbering of the segments left has gaps
+  DataLog log(dir, segment_size);
+  BOOST_CHECK_EQUAL(log.SegmentNum(), 1U);
+  BOOST_CHECK(log.Has(0, 100));
+  BOOST_CHECK(!log.Has(1, 1));
+  BOOST_CHECK(log.Append(1, 101, MakeWire(1, 101)));
+  RemoveDir(dir);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "data-store.hpp"
+#include "ndn-common.hpp"
+#include "vsync-helper.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestDataStore);
+
+using namespace ndn::vsync;
+
+// the store only counts the bytes of a wire encoding, so the data is signed
+static std::shared_ptr<ndn::Data> MakeSignedData(NodeID nid, uint64_t seq,
+                                                 ndn::time::milliseconds freshness = ndn::time::milliseconds(0)) {
+  static ndn::KeyChain key_chain;
+  auto data = std::make_shared<ndn::Data>(MakeDataName("group0", nid, seq));
+  if (freshness > ndn::time::milliseconds(0)) data->setFreshnessPeriod(freshness);
+  const std::string content = "Hello from " + std::to_string(nid);
+  data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+  key_chain.sign(*data, ndn::signingWithSha256());
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(InsertFind) {
+  DataStore store(2);
+  auto d1 = MakeSignedData(1, 3);
+  auto d2 = MakeSignedData(1, 1);
+  BOOST_CHECK(store.Insert(1, 3, d1));
+  BOOST_CHECK(!store.Insert(1, 3, d2));
+  BOOST_CHECK(!store.Insert(1, 0, d2));
+  // out of order, before the current base
+  BOOST_CHECK(store.Insert(1, 1, d2));
+  // producer beyond the initial group size
+  BOOST_CHECK(store.Insert(5, 2, d1));
+  BOOST_CHECK_EQUAL(store.Size(), 3U);
+
+  BOOST_CHECK(store.Find(1, 3) == d1);
+  BOOST_CHECK(store.Find(1, 1) == d2);
+  BOOST_CHECK(!store.Has(1, 2));
+  BOOST_CHECK(!store.Has(1, 4));
+  BOOST_CHECK(!store.Has(0, 1));
+  BOOST_CHECK(!store.Has(9, 1));
+  BOOST_CHECK(store.Has(5, 2));
+}
+
+BOOST_AUTO_TEST_CASE(Evict) {
+  DataStore store(2);
+  for (uint64_t seq = 1; seq <= 5; ++seq) {
+    BOOST_CHECK(store.Insert(0, seq, MakeSignedData(0, seq)));
+  }
+  size_t bytes = store.Bytes();
+  BOOST_CHECK(bytes > 0);
+  BOOST_CHECK_EQUAL(store.PeakBytes(), bytes);
+
+  BOOST_CHECK_EQUAL(store.EvictUpTo(0, 3), 3U);
+  BOOST_CHECK_EQUAL(store.Size(), 2U);
+  BOOST_CHECK_EQUAL(store.Evicted(), 3U);
+  BOOST_CHECK(store.Bytes() < bytes);
+  BOOST_CHECK_EQUAL(store.PeakBytes(), bytes);
+  BOOST_CHECK(!store.Has(0, 3));
+  BOOST_CHECK(store.Has(0, 4));
+  // evicted slots are not refilled
+  BOOST_CHECK(!store.Insert(0, 2, MakeSignedData(0, 2)));
+
+  // evicting past the end leaves the producer empty
+  BOOST_CHECK_EQUAL(store.EvictUpTo(0, 9), 2U);
+  BOOST_CHECK_EQUAL(store.Size(), 0U);
+  BOOST_CHECK_EQUAL(store.Bytes(), 0U);
+  BOOST_CHECK(store.Insert(0, 10, MakeSignedData(0, 10)));
+  BOOST_CHECK_EQUAL(store.EvictUpTo(1, 4), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(SeqGap) {
+  DataStore store(1);
+  BOOST_CHECK(store.Insert(0, 5, MakeSignedData(0, 5)));
+  // a bogus sequence number far from the stored run is refused
+  BOOST_CHECK(!store.Insert(0, 5 + kMaxSeqGap + 1, MakeSignedData(0, 5 + kMaxSeqGap + 1)));
+  BOOST_CHECK(!store.Insert(0, std::numeric_limits<uint64_t>::max(), MakeSignedData(0, 1)));
+  BOOST_CHECK(store.Insert(0, 5 + kMaxSeqGap, MakeSignedData(0, 5 + kMaxSeqGap)));
+  BOOST_CHECK_EQUAL(store.Size(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE(Retention) {
+  using ndn::time::milliseconds;
+  DataStore::TimePoint t0 = ndn::time::system_clock::now();
+  size_t object_bytes = MakeSignedData(0, 1)->wireEncode().size();
+
+  // byte budget: room for three objects, the ones expiring first go
+  DataStore store(2, 3 * object_bytes);
+  for (uint64_t seq = 1; seq <= 3; ++seq) {
+    BOOST_CHECK(store.Insert(0, seq, MakeSignedData(0, seq), t0));
+  }
+  BOOST_CHECK(store.Insert(1, 1, MakeSignedData(1, 1), t0 + milliseconds(1)));
+  BOOST_CHECK_EQUAL(store.Size(), 3U);
+  BOOST_CHECK(!store.Has(0, 1));
+  BOOST_CHECK(store.Has(0, 2));
+  BOOST_CHECK_EQUAL(store.RetentionHorizon(0), 2U);
+  BOOST_CHECK_EQUAL(store.RetentionHorizon(1), 1U);
+  BOOST_CHECK(store.Bytes() <= 3 * object_bytes);
+
+  // age: freshness period capped by the maximum age
+  DataStore aged(2, 0, milliseconds(1000));
+  BOOST_CHECK(aged.Insert(0, 1, MakeSignedData(0, 1, milliseconds(500)), t0));
+  BOOST_CHECK(aged.Insert(0, 2, MakeSignedData(0, 2, milliseconds(5000)), t0));
+  BOOST_CHECK(aged.Insert(1, 1, MakeSignedData(1, 1), t0 + milliseconds(100)));
+  BOOST_CHECK_EQUAL(aged.Expire(t0 + milliseconds(499)), 0U);
+  BOOST_CHECK_EQUAL(aged.Expire(t0 + milliseconds(500)), 1U);
+  BOOST_CHECK(!aged.Has(0, 1));
+  BOOST_CHECK(aged.Has(0, 2));
+  BOOST_CHECK_EQUAL(aged.Expire(t0 + milliseconds(1000)), 1U);
+  BOOST_CHECK(aged.Has(1, 1));
+  BOOST_CHECK_EQUAL(aged.Expire(t0 + milliseconds(1100)), 1U);
+  BOOST_CHECK_EQUAL(aged.Size(), 0U);
+  BOOST_CHECK_EQUAL(aged.RetentionHorizon(0), 3U);
+  BOOST_CHECK(!aged.Insert(0, 2, MakeSignedData(0, 2), t0));
+
+  // without a maximum age the freshness period does not expire anything
+  DataStore unbounded(1);
+  BOOST_CHECK(unbounded.Insert(0, 1, MakeSignedData(0, 1, milliseconds(500)), t0));
+  BOOST_CHECK_EQUAL(unbounded.Expire(t0 + milliseconds(3600 * 1000)), 0U);
+  BOOST_CHECK(unbounded.Has(0, 1));
+}
+
+BOOST_AUTO_TEST_CASE(MixedLifetimes) {
+  using ndn::time::milliseconds;
+  DataStore::TimePoint t0 = ndn::time::system_clock::now();
+  size_t object_bytes = MakeSignedData(0, 1)->wireEncode().size();
+
+  // short-lived objects published after long-lived ones still expire first
+  DataStore store(3, 0, milliseconds(10000));
+  for (uint64_t seq = 1; seq <= 4; ++seq) {
+    BOOST_CHECK(store.Insert(0, seq, MakeSignedData(0, seq, milliseconds(1000)), t0 + milliseconds(seq)));
+    BOOST_CHECK(store.Insert(1, seq, MakeSignedData(1, seq, milliseconds(100)), t0 + milliseconds(seq)));
+  }
+  BOOST_CHECK(store.Insert(2, 1, MakeSignedData(2, 1), t0));
+  BOOST_CHECK_EQUAL(store.Expire(t0 + milliseconds(102)), 2U);
+  BOOST_CHECK_EQUAL(store.RetentionHorizon(1), 3U);
+  BOOST_CHECK_EQUAL(store.RetentionHorizon(0), 1U);
+  BOOST_CHECK_EQUAL(store.Expire(t0 + milliseconds(1001)), 3U);
+  BOOST_CHECK_EQUAL(store.RetentionHorizon(0), 2U);
+  BOOST_CHECK_EQUAL(store.Expire(t0 + milliseconds(5000)), 3U);
+  BOOST_CHECK(store.Has(2, 1));
+
+  // an object the byte budget evicts right away is not held
+  DataStore small(1, object_bytes, milliseconds(10000));
+  BOOST_CHECK(small.Insert(0, 1, MakeSignedData(0, 1, milliseconds(1000)), t0));
+  BOOST_CHECK(!small.Insert(0, 2, MakeSignedData(0, 2, milliseconds(100)), t0));
+  BOOST_CHECK(!small.Has(0, 2));
+  BOOST_CHECK_EQUAL(small.RetentionHorizon(0), 3U);
+}
+
+BOOST_AUTO_TEST_CASE(SharedStore) {
+  size_t object_bytes = MakeSignedData(0, 1)->wireEncode().size();
+  auto shared = std::make_shared<DataStore>(0, 3 * object_bytes);
+  GroupDataStore g1(shared, 0), g2(shared, 4);
+
+  // producer 1 of each group is a different producer of the store
+  BOOST_CHECK(g1.Insert(1, 1, MakeSignedData(1, 1)));
+  BOOST_CHECK(g2.Insert(1, 1, MakeSignedData(1, 1)));
+  BOOST_CHECK(shared->Has(1, 1));
+  BOOST_CHECK(shared->Has(5, 1));
+  BOOST_CHECK_EQUAL(g1.Size(), 2U);
+
+  // one byte budget: the object closest to expiry goes, whatever its group
+  BOOST_CHECK(g2.Insert(2, 1, MakeSignedData(2, 1)));
+  BOOST_CHECK(g2.Insert(2, 2, MakeSignedData(2, 2)));
+  BOOST_CHECK(!g1.Has(1, 1));
+  BOOST_CHECK_EQUAL(g1.RetentionHorizon(1), 2U);
+  BOOST_CHECK_EQUAL(g2.RetentionHorizon(1), 1U);
+  BOOST_CHECK_EQUAL(g1.Evicted(), 1U);
+  BOOST_CHECK_EQUAL(g2.Evicted(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(ParseName) {
+  NodeID nid;
+  uint64_t seq;
+  BOOST_CHECK(ParseDataName(MakeDataName("group0", 4, 300), nid, seq));
+  BOOST_CHECK_EQUAL(nid, 4U);
+  BOOST_CHECK_EQUAL(seq, 300U);
+  BOOST_CHECK(!ParseDataName(MakeSyncACKInterestName("group0", 1, 2, 3, 4), nid, seq));
+  BOOST_CHECK(!ParseDataName(ndn::Name("/ndn/vsyncData/group0/abc/b"), nid, seq));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
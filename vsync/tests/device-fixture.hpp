@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#ifndef NDN_VSYNC_TESTS_DEVICE_FIXTURE_HPP_
+#define NDN_VSYNC_TESTS_DEVICE_FIXTURE_HPP_
+
+#include <memory>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include "device.hpp"
+#include "node.hpp"
+#include "vsync-helper.hpp"
+
+namespace ndn {
+namespace vsync {
+
+// a Device on a dummy face, for tests of the Nodes that run on it
+class DeviceFixture {
+ public:
+  DeviceFixture()
+      : key_chain_("pib-memory:", "tpm-memory:"),
+        face_(io_, key_chain_),
+        scheduler_(io_),
+        device(face_, scheduler_, key_chain_) {}
+
+  // a Node of 4 members in group @p gid on the device
+  std::unique_ptr<Node> Join(const GroupID& gid) {
+    return std::unique_ptr<Node>(new Node(device, 0, Name("/"), gid, 4, [] (const VersionVector&) {}));
+  }
+
+  // hands @p interest to the node it is for, as the face would
+  void Receive(const Interest& interest) {
+    face_.receive(interest);
+    io_.poll();
+  }
+
+  // object @p seq of member @p nid of group @p gid, signed so that it has a
+  // wire encoding
+  std::shared_ptr<Data> MakeSignedData(const GroupID& gid, NodeID nid, uint64_t seq,
+                                       const std::string& content = "") {
+    auto data = std::make_shared<Data>(MakeDataName(gid, nid, seq));
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    key_chain_.sign(*data, signingWithSha256());
+    return data;
+  }
+
+ private:
+  boost::asio::io_service io_;
+  KeyChain key_chain_;
+  util::DummyClientFace face_;
+  Scheduler scheduler_;
+
+ public:
+  Device device;
+};
+
+}  // namespace vsync
+}  // namespace ndn
+
+#endif  // NDN_VSYNC_TESTS_DEVICE_FIXTURE_HPP_
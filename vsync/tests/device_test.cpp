@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "device-fixture.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestDevice);
+
+using namespace ndn::vsync;
+
+BOOST_FIXTURE_TEST_CASE(FindByGroupID, DeviceFixture) {
+  auto a = Join("group0");
+  auto b = Join("group1");
+  BOOST_CHECK_EQUAL(device.GroupNum(), 2U);
+  // one device is in a group once
+  BOOST_CHECK_THROW(Join("group1"), Node::Error);
+  BOOST_CHECK_EQUAL(device.GroupNum(), 2U);
+
+  ndn::Name sync = ndn::Name(kSyncPrefix).append("group1").appendNumber(7);
+  BOOST_CHECK(device.Find(sync, kSyncPrefix.size()) == b.get());
+  ndn::Name data = ndn::Name(kSyncDataPrefix).append("group0").appendNumber(0).appendNumber(1);
+  BOOST_CHECK(device.Find(data, kSyncDataPrefix.size()) == a.get());
+  // the notified name follows /ndn/incomingData without its /ndn
+  ndn::Name incoming = ndn::Name(kIncomingDataPrefix).append("vsyncData").append("group1").appendNumber(0);
+  BOOST_CHECK(device.Find(incoming, kIncomingDataPrefix.size() + 1) == b.get());
+
+  BOOST_CHECK(device.Find(ndn::Name(kSyncPrefix).append("group2"), kSyncPrefix.size()) == nullptr);
+  BOOST_CHECK(device.Find(kSyncPrefix, kSyncPrefix.size()) == nullptr);
+
+  // a node leaves the device when it is destroyed
+  b.reset();
+  BOOST_CHECK_EQUAL(device.GroupNum(), 1U);
+  BOOST_CHECK(device.Find(sync, kSyncPrefix.size()) == nullptr);
+  BOOST_CHECK(device.Find(data, kSyncDataPrefix.size()) == a.get());
+  b = Join("group1");
+  BOOST_CHECK(device.Find(sync, kSyncPrefix.size()) == b.get());
+}
+
+BOOST_FIXTURE_TEST_CASE(SharedRadio, DeviceFixture) {
+  auto a = Join("group0");
+  BOOST_CHECK(device.IsRadioOn());
+  // the only group sleeps: so does the radio
+  device.Sleep(a.get());
+  BOOST_CHECK(!device.IsRadioOn());
+  device.Wakeup(a.get());
+  BOOST_CHECK(device.IsRadioOn());
+  BOOST_CHECK_EQUAL(device.GetRadioWakeupNum(), 1U);
+
+  auto b = Join("group1");
+  // the radio stays on while the node of any group is awake
+  device.Sleep(a.get());
+  BOOST_CHECK(device.IsRadioOn());
+  device.Wakeup(a.get());
+  device.Sleep(b.get());
+  BOOST_CHECK(device.IsRadioOn());
+  BOOST_CHECK_EQUAL(device.GetRadioWakeupSavedNum(), 0U);
+
+  // the last awake group sleeps, but the other one wakes up within
+  // kMinRadioSleep (a node that has not started is due right away)
+  device.Sleep(a.get());
+  BOOST_CHECK(device.IsRadioOn());
+  BOOST_CHECK_EQUAL(device.GetRadioWakeupSavedNum(), 1U);
+  device.Wakeup(b.get());
+  BOOST_CHECK(device.IsRadioOn());
+  BOOST_CHECK_EQUAL(device.GetRadioWakeupNum(), 1U);
+}
+
+BOOST_FIXTURE_TEST_CASE(MalformedSyncACK, DeviceFixture) {
+  auto a = Join("group0");
+  // no requester or sign, a requester that is not a number, a broken sign
+  ndn::Name group = ndn::Name(kSyncACKPrefix).append("group0");
+  BOOST_CHECK_NO_THROW(Receive(ndn::Interest(group)));
+  BOOST_CHECK_NO_THROW(Receive(ndn::Interest(ndn::Name(group).append("abc").append("3-7-5"))));
+  BOOST_CHECK_NO_THROW(Receive(ndn::Interest(ndn::Name(group).appendNumber(2).append("3-x"))));
+  // a well-formed SyncACK for another requester
+  BOOST_CHECK_NO_THROW(Receive(ndn::Interest(MakeSyncACKInterestName("group0", 3, 1, 1, 0))));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
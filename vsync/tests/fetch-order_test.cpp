@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "fetch-order.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestFetchOrder);
+
+using namespace ndn::vsync;
+
+static std::vector<FetchGap> MakeGaps() {
+  return {{0, 1, 10}, {1, 5, 6}, {2, 20, 29}};
+}
+
+BOOST_AUTO_TEST_CASE(NewestAndRandom) {
+  VersionVector head{10, 100, 30};
+  std::vector<VersionVector> neighbours;
+  std::mt19937 rengine(1);
+
+  auto gaps = MakeGaps();
+  OrderFetchGaps(kProducerOrder, gaps, head, neighbours, rengine);
+  BOOST_CHECK_EQUAL(gaps[0].nid, 0U);
+  BOOST_CHECK_EQUAL(gaps[2].nid, 2U);
+
+  // distance to the head: 0, 94 and 1
+  OrderFetchGaps(kNewestFirst, gaps, head, neighbours, rengine);
+  BOOST_CHECK_EQUAL(gaps[0].nid, 0U);
+  BOOST_CHECK_EQUAL(gaps[1].nid, 2U);
+  BOOST_CHECK_EQUAL(gaps[2].nid, 1U);
+
+  gaps = MakeGaps();
+  OrderFetchGaps(kRandomOrder, gaps, head, neighbours, rengine);
+  BOOST_CHECK_EQUAL(gaps.size(), 3U);
+  uint64_t objects = 0;
+  for (const auto& gap: gaps) objects += gap.hi - gap.lo + 1;
+  BOOST_CHECK_EQUAL(objects, 22U);
+}
+
+BOOST_AUTO_TEST_CASE(RarestFirst) {
+  VersionVector head{10, 100, 30};
+  // both neighbours hold producer 1's gap, one holds producer 0 up to 4
+  std::vector<VersionVector> neighbours{{4, 100, 0}, {0, 50, 0}};
+  std::mt19937 rengine(1);
+
+  auto gaps = MakeGaps();
+  OrderFetchGaps(kRarestFirst, gaps, head, neighbours, rengine);
+  // producer 0 is split at 4: 5-10 (no holder), 2 (no holder), then 1-4 and 1
+  BOOST_REQUIRE_EQUAL(gaps.size(), 4U);
+  BOOST_CHECK_EQUAL(gaps[0].nid, 0U);
+  BOOST_CHECK_EQUAL(gaps[0].lo, 5U);
+  BOOST_CHECK_EQUAL(gaps[0].hi, 10U);
+  BOOST_CHECK_EQUAL(gaps[1].nid, 2U);
+  BOOST_CHECK_EQUAL(gaps[2].nid, 0U);
+  BOOST_CHECK_EQUAL(gaps[2].lo, 1U);
+  BOOST_CHECK_EQUAL(gaps[2].hi, 4U);
+  BOOST_CHECK_EQUAL(gaps[3].nid, 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "fetch-window.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestFetchWindow);
+
+using namespace ndn::vsync;
+
+BOOST_AUTO_TEST_CASE(AdditiveIncrease) {
+  FetchWindow window;
+  BOOST_CHECK_EQUAL(window.Size(), FetchWindow::kInit);
+
+  // one reply grows the window by 1 / window
+  window.OnReply(false);
+  BOOST_CHECK_CLOSE(window.Size(), 2.5, 1e-9);
+  // a window of replies grows it by about one
+  window.OnReply(false);
+  window.OnReply(false);
+  BOOST_CHECK(window.Size() > 3 && window.Size() < 3.5);
+
+  // replies under contention hold the window
+  double size = window.Size();
+  window.OnReply(true);
+  BOOST_CHECK_EQUAL(window.Size(), size);
+
+  for (int i = 0; i < 1000; ++i) window.OnReply(false);
+  BOOST_CHECK_EQUAL(window.Size(), FetchWindow::kMax);
+  BOOST_CHECK_EQUAL(window.Peak(), FetchWindow::kMax);
+}
+
+BOOST_AUTO_TEST_CASE(OneHalvingPerLoss) {
+  FetchWindow window;
+  for (int i = 0; i < 10; ++i) window.OnReply(false);
+  double size = window.Size();
+
+  // a burst of four fetches all time out: only the first timeout counts
+  uint64_t burst[4];
+  for (auto& serial: burst) serial = window.OnSend();
+  BOOST_CHECK(window.OnTimeout(burst[0]));
+  BOOST_CHECK_CLOSE(window.Size(), size / 2, 1e-9);
+  for (int i = 1; i < 4; ++i) BOOST_CHECK(!window.OnTimeout(burst[i]));
+  BOOST_CHECK_CLOSE(window.Size(), size / 2, 1e-9);
+
+  // a fetch sent after the decrease is a new loss event
+  BOOST_CHECK(window.OnTimeout(window.OnSend()));
+  BOOST_CHECK_CLOSE(window.Size(), size / 4, 1e-9);
+  // the peak is kept
+  BOOST_CHECK_CLOSE(window.Peak(), size, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(Floor) {
+  FetchWindow window;
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(window.OnTimeout(window.OnSend()));
+    BOOST_CHECK(window.Size() >= FetchWindow::kMin);
+  }
+  BOOST_CHECK_EQUAL(window.Size(), FetchWindow::kMin);
+
+  // and grows again from the floor
+  window.OnReply(false);
+  BOOST_CHECK_CLOSE(window.Size(), FetchWindow::kMin + 1 / FetchWindow::kMin, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
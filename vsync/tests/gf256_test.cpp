@@ -0,0 +1,52 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+#include "gf256.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestGF256);
+
+using namespace ndn::vsync;
+
+BOOST_AUTO_TEST_CASE(Field) {
+  // x * x = x^2, and x^8 reduces to x^4 + x^3 + x^2 + 1
+  BOOST_CHECK_EQUAL(gf256::Mul(2, 2), 4);
+  BOOST_CHECK_EQUAL(gf256::Mul(0x80, 2), 0x1d);
+  for (int a = 1; a < 256; ++a) {
+    BOOST_CHECK_EQUAL(gf256::Mul(static_cast<uint8_t>(a), gf256::Inv(static_cast<uint8_t>(a))), 1);
+    BOOST_CHECK_EQUAL(gf256::Mul(static_cast<uint8_t>(a), 0), 0);
+  }
+  // distributive over XOR
+  BOOST_CHECK_EQUAL(gf256::Mul(0x53, 0x0f ^ 0xf0), gf256::Mul(0x53, 0x0f) ^ gf256::Mul(0x53, 0xf0));
+}
+
+// The AVX2 kernels must agree with the scalar ones for every length,
+// including the tails that do not fill a whole register.
+BOOST_AUTO_TEST_CASE(AVX2MatchesScalar) {
+  if (!gf256::HasAVX2()) return;
+
+  std::mt19937 rengine(42);
+  std::uniform_int_distribution<int> rdist(0, 255);
+  for (size_t n = 0; n < 100; ++n) {
+    for (int c: {0, 1, 2, 0x1d, 0x80, 0xff, rdist(rengine)}) {
+      std::vector<uint8_t> src(n), d1(n);
+      for (size_t i = 0; i < n; ++i) {
+        src[i] = static_cast<uint8_t>(rdist(rengine));
+        d1[i] = static_cast<uint8_t>(rdist(rengine));
+      }
+      auto d2 = d1;
+      gf256::MulAddScalar(d1.data(), src.data(), static_cast<uint8_t>(c), n);
+      gf256::MulAddAVX2(d2.data(), src.data(), static_cast<uint8_t>(c), n);
+      BOOST_TEST(d1 == d2, boost::test_tools::per_element());
+
+      gf256::MulScalar(d1.data(), static_cast<uint8_t>(c), n);
+      gf256::MulAVX2(d2.data(), static_cast<uint8_t>(c), n);
+      BOOST_TEST(d1 == d2, boost::test_tools::per_element());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
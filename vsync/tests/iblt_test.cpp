@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "iblt.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestIBLT);
+
+using namespace ndn::vsync;
+
+static IBLT MakeIBLT(const VersionVector& vv, size_t cells) {
+  IBLT table(cells);
+  for (const auto& item: VVItems(vv)) table.Insert(item);
+  return table;
+}
+
+static StrataEstimator MakeEstimator(const VersionVector& vv) {
+  StrataEstimator estimator;
+  for (const auto& item: VVItems(vv)) estimator.Insert(item);
+  return estimator;
+}
+
+// a vector of 300 members and a copy with @p changed entries moved on
+static void MakeVVs(size_t changed, VersionVector& a, VersionVector& b, std::mt19937& rengine) {
+  std::uniform_int_distribution<uint64_t> rdist(1, 5000);
+  a = VersionVector(300, 0);
+  for (auto& seq: a) seq = rdist(rengine);
+  b = a;
+  for (size_t i = 0; i < changed; ++i) b[(i * 7) % b.size()] += 1 + i;
+}
+
+BOOST_AUTO_TEST_CASE(ListDifference) {
+  std::mt19937 rengine(3);
+  VersionVector a, b;
+  MakeVVs(10, a, b, rengine);
+  // a member that only b has heard of
+  a[299] = 0;
+
+  IBLT ta = MakeIBLT(a, IBLT::CellsFor(21));
+  std::string wire;
+  ta.Encode(wire);
+  IBLT received, truncated;
+  BOOST_REQUIRE(received.Decode(reinterpret_cast<const uint8_t*>(wire.data()), wire.size()));
+  BOOST_CHECK(!truncated.Decode(reinterpret_cast<const uint8_t*>(wire.data()), wire.size() - 1));
+  BOOST_CHECK(received.Subtract(MakeIBLT(b, IBLT::CellsFor(21))));
+  BOOST_CHECK(!received.Subtract(MakeIBLT(b, 3)));
+
+  std::vector<SetItem> left, right;
+  BOOST_REQUIRE(received.List(left, right));
+  BOOST_CHECK_EQUAL(left.size(), 10U);
+  BOOST_CHECK_EQUAL(right.size(), 11U);
+  // rebuild a from b and the difference
+  VersionVector rebuilt = b;
+  for (const auto& item: right) rebuilt[item.nid] = 0;
+  for (const auto& item: left) rebuilt[item.nid] = item.seq;
+  BOOST_TEST(rebuilt == a);
+
+  // far too small a table cannot be listed
+  IBLT small = MakeIBLT(a, 6);
+  small.Subtract(MakeIBLT(b, 6));
+  BOOST_CHECK(!small.List(left, right));
+}
+
+BOOST_AUTO_TEST_CASE(Estimate) {
+  std::mt19937 rengine(5);
+  for (size_t changed: {0, 2, 20, 150}) {
+    VersionVector a, b;
+    MakeVVs(changed, a, b, rengine);
+    StrataEstimator ea = MakeEstimator(a);
+    std::string wire;
+    ea.Encode(wire);
+    StrataEstimator received;
+    BOOST_REQUIRE(received.Decode(reinterpret_cast<const uint8_t*>(wire.data()), wire.size()));
+    size_t estimate = received.Estimate(MakeEstimator(b));
+    // two items per changed entry; the estimate is exact when every stratum
+    // can be listed and within a small factor otherwise
+    if (changed <= 2) {
+      BOOST_CHECK_EQUAL(estimate, 2 * changed);
+    }
+    else {
+      BOOST_CHECK_GE(estimate * 4, 2 * changed);
+      BOOST_CHECK_LE(estimate, 4 * 2 * changed);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
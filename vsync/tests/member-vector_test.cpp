@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "member-vector.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestMemberVector);
+
+using ndn::vsync::MemberVector;
+using SmallVector = MemberVector<uint64_t, 4>;
+
+BOOST_AUTO_TEST_CASE(InlineAndSpill) {
+  SmallVector v(3, 7);
+  BOOST_CHECK_EQUAL(v.size(), 3U);
+  BOOST_CHECK_EQUAL(v.capacity(), 4U);
+  const uint64_t* inline_data = v.data();
+
+  v.push_back(8);
+  BOOST_CHECK(v.data() == inline_data);
+  v.push_back(9);
+  BOOST_CHECK(v.data() != inline_data);
+  BOOST_TEST(v == SmallVector({7, 7, 7, 8, 9}), boost::test_tools::per_element());
+
+  // a spilled vector keeps its heap buffer when cleared and refilled
+  const uint64_t* heap_data = v.data();
+  v.clear();
+  BOOST_CHECK(v.empty());
+  for (uint64_t i = 0; i < 5; ++i) v.push_back(i);
+  BOOST_CHECK(v.data() == heap_data);
+  BOOST_CHECK_EQUAL(v.back(), 4U);
+
+  SmallVector copy = v;
+  BOOST_TEST(copy == v, boost::test_tools::per_element());
+  // a copy of a spilled vector allocates exactly its size
+  BOOST_CHECK_EQUAL(copy.capacity(), 5U);
+  copy.resize(2);
+  BOOST_TEST(copy == SmallVector({0, 1}), boost::test_tools::per_element());
+  BOOST_CHECK(copy != v);
+}
+
+BOOST_AUTO_TEST_CASE(Move) {
+  SmallVector small({1, 2});
+  SmallVector moved(std::move(small));
+  BOOST_TEST(moved == SmallVector({1, 2}), boost::test_tools::per_element());
+  BOOST_CHECK(small.empty());
+  BOOST_CHECK_EQUAL(small.capacity(), 4U);
+  small.push_back(3);
+  BOOST_TEST(small == SmallVector({3}), boost::test_tools::per_element());
+
+  SmallVector spilled({1, 2, 3, 4, 5});
+  const uint64_t* heap_data = spilled.data();
+  moved = std::move(spilled);
+  BOOST_CHECK(moved.data() == heap_data);
+  BOOST_TEST(moved == SmallVector({1, 2, 3, 4, 5}), boost::test_tools::per_element());
+  // the moved-from vector is inline again, not an empty heap with a size
+  BOOST_CHECK(spilled.empty());
+  BOOST_CHECK_EQUAL(spilled.capacity(), 4U);
+  for (uint64_t i = 0; i < 5; ++i) spilled.push_back(i);
+  BOOST_TEST(spilled == SmallVector({0, 1, 2, 3, 4}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+#include "network-coding.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestNetworkCoding);
+
+using namespace ndn::vsync;
+
+using Store = std::map<std::pair<NodeID, uint64_t>, std::string>;
+
+static RepairDecoder::Lookup MakeLookup(const Store& store) {
+  return [&store] (NodeID nid, uint64_t seq, std::string& wire) {
+    auto it = store.find({nid, seq});
+    if (it == store.end()) return false;
+    wire = it->second;
+    return true;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(Items) {
+  std::vector<RepairItem> items{{0, 1}, {3, 1000000}, {200, 7}};
+  std::string buf;
+  AppendRepairItems(items, buf);
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(buf.data());
+  std::vector<RepairItem> decoded;
+  BOOST_CHECK(DecodeRepairItems(begin, begin + buf.size(), decoded) == begin + buf.size());
+  BOOST_CHECK(decoded == items);
+  BOOST_CHECK(DecodeRepairItems(begin, begin + buf.size() - 1, decoded) == nullptr);
+}
+
+// Two receivers that miss different parts of one generation both decode
+// from the same broadcast packets, each after as many as it misses.
+BOOST_AUTO_TEST_CASE(PartialKnowledge) {
+  Store all;
+  RepairEncoder encoder;
+  for (uint64_t seq = 1; seq <= 6; ++seq) {
+    // objects of different sizes, including an empty one
+    std::string wire(seq == 3 ? 0 : 50 * seq, static_cast<char>('a' + seq));
+    all[{1, seq}] = wire;
+    BOOST_CHECK(encoder.Add(1, seq, reinterpret_cast<const uint8_t*>(wire.data()), wire.size()));
+  }
+  BOOST_CHECK(encoder.Contains(1, 4));
+  BOOST_CHECK(!encoder.Contains(2, 4));
+
+  Store a, b;
+  a[{1, 1}] = all[{1, 1}];
+  a[{1, 2}] = all[{1, 2}];
+  a[{1, 5}] = all[{1, 5}];
+  a[{1, 6}] = all[{1, 6}];
+  b[{1, 6}] = all[{1, 6}];
+  RepairDecoder da(MakeLookup(a)), db(MakeLookup(b));
+
+  std::mt19937 rengine(7);
+  size_t packets = 0;
+  while (!db.Complete() && packets < 20) {
+    std::string packet = encoder.Encode(rengine);
+    auto p = reinterpret_cast<const uint8_t*>(packet.data());
+    da.Add(p, packet.size());
+    db.Add(p, packet.size());
+    packets++;
+    if (packets == 1) {
+      BOOST_CHECK_EQUAL(da.Unknown(), 2U);
+      BOOST_CHECK_EQUAL(db.Unknown(), 5U);
+    }
+  }
+  // random coefficients over GF(2^8) are almost always independent
+  BOOST_CHECK(da.Complete());
+  BOOST_CHECK(db.Complete());
+  BOOST_CHECK_LE(packets, 6U);
+
+  for (auto* decoder: {&da, &db}) {
+    size_t n = 0;
+    decoder->ForEachDecoded([&] (NodeID nid, uint64_t seq, const uint8_t* wire, size_t size) {
+      BOOST_CHECK(std::string(reinterpret_cast<const char*>(wire), size) == all[std::make_pair(nid, seq)]);
+      n++;
+    });
+    BOOST_CHECK_EQUAL(n, decoder->Unknown());
+  }
+
+  // packets of another generation are rejected
+  RepairEncoder other;
+  other.Add(2, 1, reinterpret_cast<const uint8_t*>("x"), 1);
+  std::string packet = other.Encode(rengine);
+  RepairDecoder dc(MakeLookup(b));
+  dc.Add(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+  BOOST_CHECK(dc.Complete());
+  BOOST_CHECK(!db.Add(reinterpret_cast<const uint8_t*>(packet.data()), packet.size()));
+  BOOST_CHECK(!db.Add(reinterpret_cast<const uint8_t*>(packet.data()), packet.size() - 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include "pending-list.hpp"
+#include "vsync-helper.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestPendingList);
+
+using namespace ndn::vsync;
+
+BOOST_AUTO_TEST_CASE(RangesAndACK) {
+  PendingList list;
+  BOOST_CHECK(list.Empty());
+  list.PushData(1, 3, 1000, 3);
+  list.PushData(2, 5, 4, 3);  // empty range
+  list.PushData(4, 7, 7, 3);
+  BOOST_CHECK_EQUAL(list.Size(), 999U);
+  BOOST_CHECK_EQUAL(list.Ranges().size(), 2U);
+  auto ack = MakeSyncACKInterestName("group0", 0, 1, 2, list.Size());
+  list.PushACK(ack, 3);
+  BOOST_CHECK_EQUAL(list.Size(), 1000U);
+  BOOST_CHECK_EQUAL(list.DataNum(), 999U);
+
+  BOOST_CHECK(list.FrontIsData());
+  BOOST_CHECK_EQUAL(list.FrontNodeID(), 1U);
+  BOOST_CHECK_EQUAL(list.FrontSeq(), 3U);
+  BOOST_CHECK_EQUAL(list.FrontLastSeq(), 1000U);
+  list.FrontRetx()--;
+  BOOST_CHECK_EQUAL(list.FrontRetx(), 2);
+  list.PopFront();
+  BOOST_CHECK_EQUAL(list.FrontSeq(), 4U);
+  BOOST_CHECK_EQUAL(list.FrontRetx(), 3);
+
+  // removing from the middle splits the range
+  BOOST_CHECK(list.Contains(1, 500));
+  BOOST_CHECK(list.Remove(1, 500));
+  BOOST_CHECK(!list.Contains(1, 500));
+  BOOST_CHECK(!list.Remove(1, 500));
+  BOOST_CHECK(list.Contains(1, 499));
+  BOOST_CHECK(list.Contains(1, 501));
+  BOOST_CHECK_EQUAL(list.Ranges().size(), 3U);
+  BOOST_CHECK(list.Remove(1, 4));
+  BOOST_CHECK_EQUAL(list.FrontSeq(), 5U);
+  BOOST_CHECK(list.Remove(4, 7));
+  BOOST_CHECK_EQUAL(list.DataNum(), 995U);
+
+  while (list.FrontIsData()) list.PopFront();
+  BOOST_CHECK(list.OnlyACK());
+  BOOST_CHECK(list.ACKName() == ack);
+  list.PopFront();
+  BOOST_CHECK(list.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(Duplicates) {
+  PendingList list;
+  list.PushData(0, 10, 20, 3);
+  list.PushData(0, 30, 40, 3);
+  // only 5-9, 21-29 and 41-45 are new
+  list.PushData(0, 5, 45, 3);
+  BOOST_CHECK_EQUAL(list.DataNum(), 41U);
+  BOOST_CHECK_EQUAL(list.Ranges().size(), 5U);
+  list.PushData(0, 12, 18, 3);
+  BOOST_CHECK_EQUAL(list.DataNum(), 41U);
+  for (uint64_t seq = 5; seq <= 45; ++seq) BOOST_CHECK(list.Contains(0, seq));
+  BOOST_CHECK(!list.Contains(0, 4));
+  BOOST_CHECK(!list.Contains(0, 46));
+  BOOST_CHECK(!list.Contains(1, 10));
+
+  // fetch order is kept: first the original ranges, then the new parts
+  BOOST_CHECK_EQUAL(list.FrontSeq(), 10U);
+  BOOST_CHECK_EQUAL(list.PeakSize(), 41U);
+  BOOST_CHECK_EQUAL(list.PeakRangeNum(), 5U);
+  list.Remove(0, 15);
+  BOOST_CHECK_EQUAL(list.PeakRangeNum(), 6U);
+  list.Clear();
+  BOOST_CHECK(list.Empty());
+  BOOST_CHECK_EQUAL(list.PeakSize(), 41U);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
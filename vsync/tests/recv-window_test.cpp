@@ -1,4 +1,209 @@
 /* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "recv-window.hpp"
+
+using ndn::vsync::ReceiveWindow;
+using ndn::vsync::BitmapReceiveWindow;
+
+BOOST_AUTO_TEST_SUITE(TestReceiveWindows);
+
+// every test runs against both implementations
+using Windows = boost::mpl::list<ReceiveWindow, BitmapReceiveWindow>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndHasData, W, Windows) {
+  W rw;
+  BOOST_CHECK(!rw.HasData(1));
+  rw.Insert(1);
+  rw.Insert(2);
+  rw.Insert(5);
+  rw.Insert(70);
+  BOOST_CHECK(rw.HasData(1));
+  BOOST_CHECK(rw.HasData(2));
+  BOOST_CHECK(!rw.HasData(3));
+  BOOST_CHECK(rw.HasData(5));
+  BOOST_CHECK(rw.HasData(70));
+  BOOST_CHECK(!rw.HasData(69));
+  BOOST_CHECK(!rw.HasData(71));
+  // duplicates are harmless
+  rw.Insert(5);
+  BOOST_CHECK(rw.HasData(5));
+  BOOST_CHECK(!rw.HasData(4));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(CheckForMissingData, W, Windows) {
+  using SeqNumInterval = typename W::SeqNumInterval;
+  using SeqNumIntervalSet = typename W::SeqNumIntervalSet;
+  W rw;
+  BOOST_CHECK(rw.CheckForMissingData(0).empty());
+
+  SeqNumIntervalSet expected;
+  expected.insert(SeqNumInterval::closed(1, 3));
+  BOOST_CHECK(rw.CheckForMissingData(3) == expected);
+
+  rw.Insert(1);
+  rw.Insert(3);
+  rw.Insert(6);
+  expected.clear();
+  expected.insert(SeqNumInterval::closed(2, 2));
+  expected.insert(SeqNumInterval::closed(4, 5));
+  expected.insert(SeqNumInterval::closed(7, 200));
+  BOOST_CHECK(rw.CheckForMissingData(200) == expected);
+
+  expected.clear();
+  expected.insert(SeqNumInterval::closed(2, 2));
+  BOOST_CHECK(rw.CheckForMissingData(3) == expected);
+  BOOST_CHECK(rw.CheckForMissingData(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(HasAllData, W, Windows) {
+  W rw;
+  BOOST_CHECK(!rw.HasAllData());
+  BOOST_CHECK(!rw.HasAllDataBefore(1));
+  rw.Insert(2);
+  rw.Insert(3);
+  BOOST_CHECK(rw.HasAllData());
+  BOOST_CHECK(!rw.HasAllDataBefore(3));
+  BOOST_CHECK(rw.HasAllDataIn(2, 3));
+  BOOST_CHECK(!rw.HasAllDataIn(1, 3));
+  rw.Insert(5);
+  BOOST_CHECK(!rw.HasAllData());
+  rw.Insert(1);
+  rw.Insert(4);
+  BOOST_CHECK(rw.HasAllData());
+  BOOST_CHECK(rw.HasAllDataBefore(5));
+  BOOST_CHECK(!rw.HasAllDataBefore(6));
+  BOOST_CHECK(rw.HasAllDataIn(3, 5));
+  BOOST_CHECK(!rw.HasAllDataIn(3, 6));
+  BOOST_CHECK(rw.HasAllDataIn(7, 6));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(LastAckedData, W, Windows) {
+  W rw;
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 0U);
+  rw.Insert(1);
+  rw.Insert(3);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 1U);
+  // fill a gap that spans several bitmap words
+  for (uint64_t seq = 200; seq >= 4; --seq) rw.Insert(seq);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 1U);
+  rw.Insert(2);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 200U);
+  BOOST_CHECK(rw.HasAllData());
+}
+
+BOOST_AUTO_TEST_CASE(MissingTracking) {
+  BitmapReceiveWindow rw;
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 0U);
+  rw.SetHead(10);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 10U);
+  rw.Insert(1);
+  rw.Insert(4);
+  rw.Insert(4);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 8U);
+  // inserting past the head moves it
+  rw.Insert(80);
+  BOOST_CHECK_EQUAL(rw.Head(), 80U);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 77U);
+  rw.SetHead(5);
+  BOOST_CHECK_EQUAL(rw.Head(), 80U);
+
+  std::vector<std::pair<uint64_t, uint64_t>> gaps;
+  rw.ForEachMissing(rw.Head(), [&gaps] (uint64_t lo, uint64_t hi) { gaps.emplace_back(lo, hi); });
+  BOOST_REQUIRE_EQUAL(gaps.size(), 2U);
+  BOOST_CHECK_EQUAL(gaps[0].first, 2U);
+  BOOST_CHECK_EQUAL(gaps[0].second, 3U);
+  BOOST_CHECK_EQUAL(gaps[1].first, 5U);
+  BOOST_CHECK_EQUAL(gaps[1].second, 79U);
+
+  for (uint64_t seq = 2; seq < 80; ++seq) rw.Insert(seq);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 0U);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 80U);
+}
+
+BOOST_AUTO_TEST_CASE(SeqGap) {
+  BitmapReceiveWindow rw;
+  rw.Insert(1);
+  // a bogus sequence number far past the watermark is refused
+  BOOST_CHECK(!rw.Accepts(2 + ndn::vsync::kMaxSeqGap));
+  BOOST_CHECK(!rw.Insert(2 + ndn::vsync::kMaxSeqGap));
+  BOOST_CHECK(!rw.Insert(std::numeric_limits<uint64_t>::max()));
+  BOOST_CHECK(!rw.HasData(2 + ndn::vsync::kMaxSeqGap));
+  BOOST_CHECK_EQUAL(rw.Head(), 1U);
+  BOOST_CHECK(rw.Accepts(1 + ndn::vsync::kMaxSeqGap));
+  BOOST_CHECK(rw.Insert(1 + ndn::vsync::kMaxSeqGap));
+  BOOST_CHECK_EQUAL(rw.MissingNum(), ndn::vsync::kMaxSeqGap - 1);
+}
+
+BOOST_AUTO_TEST_CASE(AdvanceTo) {
+  BitmapReceiveWindow rw;
+  for (uint64_t seq = 1; seq <= 5; ++seq) rw.Insert(seq);
+  rw.Insert(8);
+  rw.SetHead(20);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 14U);
+
+  // 6-10 were evicted everywhere before we got 6, 7, 9 and 10: give them up,
+  // and the received 11 and 12 join the watermark
+  rw.Insert(12);
+  rw.Insert(11);
+  rw.AdvanceTo(10);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 12U);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 8U);
+  BOOST_CHECK(rw.CheckForMissingData(20) ==
+              BitmapReceiveWindow::SeqNumIntervalSet{BitmapReceiveWindow::SeqNumInterval::closed(13, 20)});
+  // behind the watermark is a no-op
+  rw.AdvanceTo(4);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 12U);
+
+  // past the head moves the head too
+  rw.AdvanceTo(30);
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 30U);
+  BOOST_CHECK_EQUAL(rw.Head(), 30U);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(EvictedGap) {
+  BitmapReceiveWindow rw;
+  rw.Insert(1);
+  // 2-100 were evicted before we got them, so the retention horizon is 101
+  // and Node::OnEviction moves the watermark to 100; the producer goes on
+  // publishing more than kMaxSeqGap objects
+  rw.AdvanceTo(100);
+  for (uint64_t seq = 101; seq <= 101 + ndn::vsync::kMaxSeqGap + 10; ++seq) {
+    BOOST_REQUIRE(rw.Accepts(seq));
+    BOOST_REQUIRE(rw.Insert(seq));
+  }
+  BOOST_CHECK_EQUAL(rw.LastAckedData(), 101 + ndn::vsync::kMaxSeqGap + 10);
+  BOOST_CHECK_EQUAL(rw.MissingNum(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(SameWindows) {
+  // random mostly-in-order arrivals give the same windows in both
+  ReceiveWindow rw;
+  BitmapReceiveWindow brw;
+  uint64_t state = 42;
+  for (uint64_t seq = 1; seq <= 2000; ++seq) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t s = seq + (state >> 60);  // up to 15 ahead
+    rw.Insert(s);
+    brw.Insert(s);
+    if (seq % 97 == 0) {
+      BOOST_CHECK(rw.getWin() == brw.getWin());
+      BOOST_CHECK_EQUAL(rw.LastAckedData(), brw.LastAckedData());
+      BOOST_CHECK(rw.CheckForMissingData(seq + 20) == brw.CheckForMissingData(seq + 20));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+// Tests for the earlier ESN-based interface of ReceiveWindow
 /*
 #include <boost/test/unit_test.hpp>
 
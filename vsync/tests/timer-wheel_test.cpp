@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "timer-wheel.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestTimerWheel);
+
+using namespace ndn::vsync;
+using ndn::time::milliseconds;
+
+// a wheel driven by hand that records its wake-ups
+class TestWheel : public TimerWheel {
+ public:
+  std::vector<uint64_t> wakes;
+
+ protected:
+  void OnWake(uint64_t tick) override { wakes.push_back(tick); }
+};
+
+BOOST_AUTO_TEST_CASE(FireInOrder) {
+  TestWheel wheel;
+  std::vector<std::pair<int, uint64_t>> fired;
+  TimerWheel::Timer a(wheel, [&] { fired.push_back({1, wheel.CurrentTick()}); });
+  TimerWheel::Timer b(wheel, [&] { fired.push_back({2, wheel.CurrentTick()}); });
+  TimerWheel::Timer c(wheel, [&] { fired.push_back({3, wheel.CurrentTick()}); });
+  a.Arm(milliseconds(30));
+  b.Arm(milliseconds(5));
+  c.Arm(milliseconds(5000));
+  BOOST_CHECK_EQUAL(wheel.Size(), 3U);
+  BOOST_CHECK_EQUAL(wheel.NextTick(), 5U);
+
+  wheel.Advance(4);
+  BOOST_CHECK(fired.empty());
+  wheel.Advance(100);
+  BOOST_REQUIRE_EQUAL(fired.size(), 2U);
+  BOOST_CHECK_EQUAL(fired[0].first, 2);
+  BOOST_CHECK_EQUAL(fired[0].second, 5U);
+  BOOST_CHECK_EQUAL(fired[1].first, 1);
+  BOOST_CHECK_EQUAL(fired[1].second, 30U);
+  BOOST_CHECK_EQUAL(wheel.CurrentTick(), 100U);
+  BOOST_CHECK(!a.IsArmed());
+  BOOST_CHECK(c.IsArmed());
+
+  wheel.Advance(10000);
+  BOOST_REQUIRE_EQUAL(fired.size(), 3U);
+  BOOST_CHECK_EQUAL(fired[2].first, 3);
+  BOOST_CHECK_EQUAL(fired[2].second, 5000U);
+  BOOST_CHECK_EQUAL(wheel.Size(), 0U);
+  BOOST_CHECK_EQUAL(wheel.NextTick(), TimerWheel::kNever);
+  BOOST_CHECK_EQUAL(wheel.GetFiredNum(), 3U);
+}
+
+BOOST_AUTO_TEST_CASE(RearmAndCancel) {
+  TestWheel wheel;
+  int fired = 0;
+  TimerWheel::Timer wt(wheel, [&] { fired++; });
+  // re-armed on every overheard interest, as the WT timer
+  for (uint64_t t = 0; t < 200; t += 10) {
+    wheel.Advance(t);
+    wt.Arm(milliseconds(23));
+  }
+  BOOST_CHECK_EQUAL(fired, 0);
+  BOOST_CHECK_EQUAL(wheel.Size(), 1U);
+  wheel.Advance(300);
+  BOOST_CHECK_EQUAL(fired, 1);
+
+  wt.Arm(milliseconds(10));
+  wt.Cancel();
+  BOOST_CHECK(!wt.IsArmed());
+  wheel.Advance(1000);
+  BOOST_CHECK_EQUAL(fired, 1);
+  BOOST_CHECK_EQUAL(wheel.GetArmNum(), 21U);
+}
+
+BOOST_AUTO_TEST_CASE(Periodic) {
+  // a callback re-arms its own timer, as CheckState does
+  TestWheel wheel;
+  std::vector<uint64_t> ticks;
+  TimerWheel::Timer timer(wheel);
+  timer.Arm(milliseconds(4000), [&] {
+    ticks.push_back(wheel.CurrentTick());
+    timer.Arm(milliseconds(4000));
+  });
+  wheel.Advance(40000);
+  BOOST_REQUIRE_EQUAL(ticks.size(), 10U);
+  for (size_t i = 0; i < ticks.size(); ++i) BOOST_CHECK_EQUAL(ticks[i], 4000 * (i + 1));
+}
+
+BOOST_AUTO_TEST_CASE(BeyondRange) {
+  TestWheel wheel;
+  uint64_t at = 0;
+  TimerWheel::Timer timer(wheel, [&] { at = wheel.CurrentTick(); });
+  uint64_t range = uint64_t(1) << (TimerWheel::kLevelBits * TimerWheel::kLevels);
+  timer.Arm(milliseconds(3 * range + 7));
+  wheel.Advance(3 * range);
+  BOOST_CHECK_EQUAL(at, 0U);
+  wheel.Advance(4 * range);
+  BOOST_CHECK_EQUAL(at, 3 * range + 7);
+}
+
+BOOST_AUTO_TEST_CASE(WakeUps) {
+  TestWheel wheel;
+  TimerWheel::Timer a(wheel);
+  TimerWheel::Timer b(wheel);
+  a.Arm(milliseconds(50));
+  BOOST_REQUIRE_EQUAL(wheel.wakes.size(), 1U);
+  BOOST_CHECK_EQUAL(wheel.wakes.back(), 50U);
+  // later timers, and re-arming to later, leave the wake-up alone
+  b.Arm(milliseconds(70));
+  a.Arm(milliseconds(60));
+  BOOST_CHECK_EQUAL(wheel.wakes.size(), 1U);
+  // an earlier one moves it
+  b.Arm(milliseconds(20));
+  BOOST_REQUIRE_EQUAL(wheel.wakes.size(), 2U);
+  BOOST_CHECK_EQUAL(wheel.wakes.back(), 20U);
+  // the far timers wake the wheel when their slot moves down
+  wheel.Advance(20);
+  BOOST_CHECK_EQUAL(wheel.wakes.back(), 60U);
+  TimerWheel::Timer c(wheel);
+  c.Cancel();
+  a.Cancel();
+  // due at 1020, moved down at 960
+  c.Arm(milliseconds(1000));
+  wheel.Advance(60);
+  BOOST_CHECK_EQUAL(wheel.wakes.back(), 960U);
+}
+
+BOOST_AUTO_TEST_CASE(Random) {
+  // against the expected firing ticks, with re-arms and cancels
+  TestWheel wheel;
+  std::mt19937 rengine(7);
+  const size_t n = 200;
+  std::vector<uint64_t> due(n, 0);
+  std::vector<uint64_t> fired_at(n, 0);
+  std::vector<std::unique_ptr<TimerWheel::Timer>> timers;
+  for (size_t i = 0; i < n; ++i) {
+    timers.emplace_back(new TimerWheel::Timer(wheel, [&, i] { fired_at[i] = wheel.CurrentTick(); }));
+  }
+  std::uniform_int_distribution<uint64_t> delay(1, 300000);
+  std::uniform_int_distribution<size_t> pick(0, n - 1);
+  std::uniform_int_distribution<uint64_t> step(0, 5000);
+  uint64_t now = 0;
+  for (int round = 0; round < 2000; ++round) {
+    size_t i = pick(rengine);
+    if (round % 5 == 0) {
+      timers[i]->Cancel();
+      due[i] = 0;
+    }
+    else {
+      due[i] = now + delay(rengine);
+      fired_at[i] = 0;
+      timers[i]->Arm(milliseconds(due[i] - now));
+    }
+    now += step(rengine);
+    wheel.Advance(now);
+    for (size_t j = 0; j < n; ++j) {
+      if (due[j] != 0 && due[j] <= now) {
+        BOOST_CHECK_EQUAL(fired_at[j], due[j]);
+        due[j] = 0;
+      }
+    }
+  }
+  for (size_t j = 0; j < n; ++j) BOOST_CHECK_EQUAL(timers[j]->IsArmed(), due[j] != 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
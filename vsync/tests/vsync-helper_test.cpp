@@ -11,7 +11,7 @@ BOOST_AUTO_TEST_SUITE(TestVsyncHelper);
 
 using namespace ndn::vsync;
 
-/*BOOST_AUTO_TEST_CASE(MergeVV) {
+BOOST_AUTO_TEST_CASE(MergeVV) {
   VersionVector v1{1, 0, 5};
   VersionVector v2{2, 4, 1};
   auto r1 = ndn::vsync::Merge(v1, v2);
@@ -20,17 +20,236 @@ using namespace ndn::vsync;
   VersionVector v3{1, 0};
   auto r2 = ndn::vsync::Merge(v1, v3);
   BOOST_TEST(r2 == VersionVector());
-}*/
 
-/*BOOST_AUTO_TEST_CASE(VVEncodeDecode) {
-  VersionVector v1{{"a", 1}, {"b", 5}, {"c", 2}, {"d", 4}, {"e", 3}};
-  std::string out;
-  EncodeVV(v1, out);
-  VersionVector v2 = DecodeVV(out.data(), out.size());
+  BOOST_TEST(MergeInto(v1, v2));
+  BOOST_TEST(v1 == r1, boost::test_tools::per_element());
+  BOOST_TEST(!MergeInto(v1, v3));
+}
+
+BOOST_AUTO_TEST_CASE(CompareVV) {
+  VersionVector v1{1, 0, 5};
+  VersionVector v2{2, 4, 1};
+  VersionVector v3{2, 4, 5};
+  BOOST_TEST(Concurrent(v1, v2));
+  BOOST_TEST(!Dominates(v1, v2));
+  BOOST_TEST(Dominates(v3, v1));
+  BOOST_TEST(Dominates(v3, v3));
+  BOOST_TEST(!Concurrent(v3, v1));
+  BOOST_TEST(Equal(v3, VersionVector({2, 4, 5})));
+  BOOST_TEST(!Equal(v3, v2));
+  BOOST_TEST(VVCompare()(v1, v3));
+  BOOST_TEST(!VVCompare()(v3, v3));
+  BOOST_TEST(!VVCompare()(v1, v2));
+}
+
+BOOST_AUTO_TEST_CASE(VVEncodeDecode) {
+  VersionVector v1{1, 5, 0, 127, 128, 300, 0xffffffffffffffff};
+  auto c = EncodeVVBinary(v1);
+  // 1 byte per entry below 128, 2 bytes up to 16383, 10 bytes for 2^64-1
+  BOOST_CHECK_EQUAL(c.value_size(), 4U + 2U + 2U + 10U);
+  VersionVector v2;
+  BOOST_TEST(DecodeVVBinary(c, v2));
+  BOOST_TEST(v1 == v2, boost::test_tools::per_element());
+
+  // a truncated varint is rejected
+  BOOST_TEST(!DecodeVVBinary(c.value(), c.value_size() - 1, v2));
+
+  auto n = MakeSyncInterestName("group0", 3, c, 7);
+  BOOST_TEST(DecodeVVBinary(ExtractEncodedVVComponent(n), v2));
   BOOST_TEST(v1 == v2, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(ExtractSyncIndex(n), 7U);
+  BOOST_CHECK_EQUAL(ExtractNodeID(n), 3U);
+
+  std::string legacy = EncodeVV(v1);
+  BOOST_CHECK_EQUAL(legacy, "1-5-0-127-128-300-18446744073709551615-");
+  BOOST_TEST(DecodeVV(legacy) == v1, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(VVDelta) {
+  VersionVector base{3, 7, 0, 2};
+  VersionVector v{3, 9, 1, 2};
+  auto c = EncodeVVDelta(base, v);
+  // only entries 1 and 2 changed: two (index, seq) pairs
+  BOOST_CHECK_EQUAL(c.value_size(), 4U);
+  VersionVector r = base;
+  BOOST_TEST(ApplyVVDelta(c, r));
+  BOOST_TEST(r == v, boost::test_tools::per_element());
+
+  BOOST_TEST(EncodeVVDelta(v, v).value_size() == 0U);
+  BOOST_TEST(VVDigest(base) != VVDigest(v));
+  BOOST_TEST(VVDigest(r) == VVDigest(v));
+
+  // an index beyond the vector is rejected
+  VersionVector small{3, 7};
+  BOOST_TEST(!ApplyVVDelta(c, small));
+
+  auto n = MakeDeltaSyncInterestName("group0", 2, VVDigest(base), c, 5);
+  BOOST_TEST(IsDeltaSyncInterestName(n));
+  BOOST_TEST(!IsDeltaSyncInterestName(MakeSyncInterestName("group0", 2, EncodeVVBinary(v), 5)));
+  // the marker, not the length, tells the two apart
+  BOOST_TEST(!IsDeltaSyncInterestName(MakeSyncInterestName("group0", 2, EncodeVVBinary(v), 5).append("extra")));
+  BOOST_TEST(IsDeltaSyncInterestName(ndn::Name(n).append("extra")));
+  BOOST_CHECK_EQUAL(ExtractBaseDigest(n), VVDigest(base));
+  BOOST_CHECK_EQUAL(ExtractSyncIndex(n), 5U);
+  BOOST_CHECK_EQUAL(ExtractNodeID(n), 2U);
+}
+
+BOOST_AUTO_TEST_CASE(StateDigest) {
+  VersionVector v1{3, 9, 1, 2};
+  VersionVector v2{3, 9, 2, 1};
+  BOOST_TEST(VVStateDigest(v1) != VVStateDigest(v2));
+
+  // update one entry incrementally
+  uint64_t digest = VVStateDigest(v1);
+  digest -= VVEntryDigest(2, v1[2]);
+  v1[2] = 7;
+  digest += VVEntryDigest(2, v1[2]);
+  BOOST_CHECK_EQUAL(digest, VVStateDigest(v1));
+
+  auto n = MakeSyncInterestName("group0", 1, EncodeVVBinary(v1), 4, digest);
+  BOOST_CHECK_EQUAL(ExtractStateDigest(n), digest);
+  n = MakeDeltaSyncInterestName("group0", 1, VVDigest(v2), EncodeVVDelta(v2, v1), 4, digest);
+  BOOST_CHECK_EQUAL(ExtractStateDigest(n), digest);
+}
+
+BOOST_AUTO_TEST_CASE(IBLTNames) {
+  auto n = MakeIBLTSyncInterestName("group0", 2, std::string("\x01\x02\x03", 3), 5, 77);
+  BOOST_TEST(IsIBLTSyncInterestName(n));
+  BOOST_TEST(!IsDeltaSyncInterestName(n));
+  BOOST_TEST(!IsIBLTSyncInterestName(MakeDeltaSyncInterestName("group0", 2, 0, EncodeVVDelta({1}, {1}), 5)));
+  BOOST_CHECK_EQUAL(ExtractStateDigest(n), 77U);
+  BOOST_CHECK_EQUAL(ExtractSyncIndex(n), 5U);
+  BOOST_CHECK_EQUAL(ExtractNodeID(n), 2U);
+  BOOST_CHECK_EQUAL(ExtractEncodedVVComponent(n).value_size(), 3U);
+
+  NodeID requester;
+  uint64_t sync_index;
+  size_t cells;
+  BOOST_TEST(ParseIBLTRequestName(MakeIBLTRequestName("group0", 2, 5, 48), requester, sync_index, cells));
+  BOOST_CHECK_EQUAL(requester, 2U);
+  BOOST_CHECK_EQUAL(sync_index, 5U);
+  BOOST_CHECK_EQUAL(cells, 48U);
+  BOOST_TEST(!ParseIBLTRequestName(MakeVVRequestName("group0", 2, 5), requester, sync_index, cells));
+}
+
+BOOST_AUTO_TEST_CASE(StabilityInfo) {
+  VersionVector vv{10, 20, 30, 40};
+  VersionVector token{8, 20, 25, 40};
+  VersionVector stable{5, 15, 30, 0};
+  auto c = EncodeStabilityInfo(vv, 3, token, stable);
+
+  uint64_t count;
+  VersionVector token2, stable2;
+  BOOST_TEST(DecodeStabilityInfo(c, vv, count, token2, stable2));
+  BOOST_CHECK_EQUAL(count, 3U);
+  BOOST_TEST(token2 == token);
+  BOOST_TEST(stable2 == stable);
+
+  auto n = MakeDeltaSyncInterestName("group0", 1, VVDigest(vv), EncodeVVDelta(vv, vv), 4, 0, c);
+  BOOST_TEST(IsDeltaSyncInterestName(n));
+  BOOST_CHECK(ExtractStabilityInfo(n) == c);
+  BOOST_CHECK_EQUAL(ExtractSyncIndex(n), 4U);
+
+  // an index outside the vector is rejected
+  VersionVector small{1, 2};
+  BOOST_TEST(!DecodeStabilityInfo(c, small, count, token2, stable2));
+}
+
+BOOST_AUTO_TEST_CASE(SyncReplyRequest) {
+  auto ack = MakeSyncACKInterestName("group0", 2, 3, 7, 5);
+  VersionVector from(4, 9);
+  BOOST_TEST(ExtractSyncReplyRequest(ack, from));
+  BOOST_TEST(from == VersionVector(4, 0));
+
+  VersionVector request{0, 12, 0, 1};
+  auto n = MakeSyncACKInterestName("group0", 2, 3, 7, 5, EncodeSyncReplyRequest(request));
+  BOOST_CHECK_EQUAL(n.size(), ack.size() + 1);
+  BOOST_CHECK_EQUAL(ExtractSyncACKRequester(n), 2U);
+  BOOST_CHECK_EQUAL(ExtractSyncACKSign(n), ExtractSyncACKSign(ack));
+  BOOST_CHECK_EQUAL(ExtractSyncACKSign(n), "3-7-5");
+  BOOST_TEST(ExtractSyncReplyRequest(n, from));
+  BOOST_TEST(from == request);
+
+  // a request for a producer outside the group is rejected
+  VersionVector small(2, 0);
+  BOOST_TEST(!ExtractSyncReplyRequest(n, small));
+}
+
+BOOST_AUTO_TEST_CASE(SyncACKNotification) {
+  // the notification of an overheard SyncACK, which keeps the name of the
+  // SyncACK after the notification prefix
+  VersionVector request{0, 12, 0, 1};
+  for (const auto& ack: {MakeSyncACKInterestName("group0", 2, 3, 7, 5),
+                         MakeSyncACKInterestName("group0", 2, 3, 7, 5, EncodeSyncReplyRequest(request))}) {
+    ndn::Name notification(kIncomignSyncACKPrefix);
+    notification.append("group0").append(ack.getSubName(1));
+    for (const auto& n: {ack, notification}) {
+      BOOST_CHECK_EQUAL(SyncACKSignPosition(n), ack.size() == 5 ? -1 : -2);
+      BOOST_CHECK_EQUAL(ExtractSyncACKRequester(n), 2U);
+      BOOST_CHECK_EQUAL(ExtractSyncACKSign(n), "3-7-5");
+      VersionVector from(4, 9);
+      BOOST_TEST(ExtractSyncReplyRequest(n, from));
+      BOOST_TEST(from == (ack.size() == 5 ? VersionVector(4, 0) : request));
+    }
+  }
+
+  ndn::name::Component gid;
+  NodeID requester, responder;
+  uint64_t index, size;
+  auto ack = MakeSyncACKInterestName("group1", 2, 13, 7, 25);
+  BOOST_TEST(ParseSyncACKName(ack, gid, requester, responder, index, size));
+  BOOST_CHECK(gid == ndn::name::Component("group1"));
+  BOOST_CHECK_EQUAL(requester, 2U);
+  BOOST_CHECK_EQUAL(responder, 13U);
+  BOOST_CHECK_EQUAL(index, 7U);
+  BOOST_CHECK_EQUAL(size, 25U);
+
+  // names without a sign, or with a requester that is not a number
+  BOOST_CHECK_EQUAL(SyncACKSignPosition(MakeDataName("group0", 1, 2)), 0);
+  BOOST_TEST(!ParseSyncACKName(MakeDataName("group0", 1, 2), gid, requester, responder, index, size));
+  BOOST_TEST(!ParseSyncACKName(ndn::Name("/ndn/syncACK/group0/abc/3-7-5"), gid, requester, responder, index, size));
+  BOOST_TEST(!IsSyncACKSign(ndn::name::Component("3-7")));
+  BOOST_TEST(!IsSyncACKSign(ndn::name::Component("3--5")));
+  BOOST_TEST(!IsSyncACKSign(ndn::name::Component("a-7-5")));
+}
+
+BOOST_AUTO_TEST_CASE(DataListNames) {
+  NodeID nid;
+  uint64_t seq;
+  uint64_t lo, hi;
+  auto list_name = MakeDataListName("group0", 4, 300, 310);
+  BOOST_CHECK(ParseDataListName(list_name, nid, lo, hi));
+  BOOST_CHECK_EQUAL(nid, 4U);
+  BOOST_CHECK_EQUAL(lo, 300U);
+  BOOST_CHECK_EQUAL(hi, 310U);
+  // the reply carries the last sequence number in the bundle
+  BOOST_CHECK(ParseDataListName(ndn::Name(list_name).appendNumber(305), nid, lo, hi));
+  BOOST_CHECK_EQUAL(hi, 310U);
+  BOOST_CHECK(!ParseDataName(list_name, nid, seq));
+  BOOST_CHECK(!ParseDataListName(MakeDataName("group0", 4, 300), nid, lo, hi));
+  BOOST_CHECK(!ParseDataListName(MakeDataListName("group0", 4, 310, 300), nid, lo, hi));
+
+  // pushed data lists are told apart from fetched ones
+  auto push_name = MakePushDataName("group0", 4, 300, 310);
+  BOOST_CHECK(IsPushName(push_name));
+  BOOST_CHECK(IsPushName(MakePushInterestName("group0")));
+  BOOST_CHECK(MakePushInterestName("group0").isPrefixOf(push_name));
+  BOOST_CHECK(!IsPushName(list_name));
+  BOOST_CHECK(!ParseDataListName(push_name, nid, lo, hi));
+
+  // repair requests and coded packet interests
+  uint64_t sync_index;
+  bool is_request;
+  BOOST_CHECK(ParseRepairName(MakeRepairRequestName("group0", 2, 7, 4, "\x01\x04\x05"), nid, sync_index, is_request));
+  BOOST_CHECK_EQUAL(nid, 2U);
+  BOOST_CHECK_EQUAL(sync_index, 7U);
+  BOOST_CHECK(is_request);
+  BOOST_CHECK(ParseRepairName(MakeRepairInterestName("group0", 2, 7, 3), nid, sync_index, is_request));
+  BOOST_CHECK(!is_request);
+  BOOST_CHECK(!ParseRepairName(list_name, nid, sync_index, is_request));
 }
 
-BOOST_AUTO_TEST_CASE(VIEncodeDecode) {
+/*BOOST_AUTO_TEST_CASE(VIEncodeDecode) {
   ViewInfo v1{{"a", Name("1")}, {"b", Name("5")}, {"c", Name("2")}, {"d", Name("4")}, {"e", Name("3")}};
   std::string out;
   EncodeVV(v1, out);
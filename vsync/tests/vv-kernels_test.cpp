@@ -0,0 +1,40 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+#include "vv-kernels.hpp"
+
+BOOST_AUTO_TEST_SUITE(TestVVKernels);
+
+using namespace ndn::vsync;
+
+// The AVX2 kernels must agree with the scalar ones for every length,
+// including the tails that do not fill a whole register.
+BOOST_AUTO_TEST_CASE(AVX2MatchesScalar) {
+  if (!vv_kernels::HasAVX2()) return;
+
+  std::mt19937 rengine(42);
+  std::uniform_int_distribution<uint64_t> rdist(0, 3);
+  for (size_t n = 0; n < 70; ++n) {
+    for (int round = 0; round < 20; ++round) {
+      VersionVector l(n), r(n);
+      for (size_t i = 0; i < n; ++i) {
+        // include values with the top bit set to exercise the unsigned compare
+        l[i] = rdist(rengine) << (round % 2 ? 62 : 0);
+        r[i] = rdist(rengine) << (round % 2 ? 62 : 0);
+      }
+      if (round % 5 == 0) r = l;
+
+      VersionVector m1(n), m2(n);
+      vv_kernels::MergeScalar(m1.data(), l.data(), r.data(), n);
+      vv_kernels::MergeAVX2(m2.data(), l.data(), r.data(), n);
+      BOOST_TEST(m1 == m2, boost::test_tools::per_element());
+      BOOST_CHECK_EQUAL(vv_kernels::CompareScalar(l.data(), r.data(), n),
+                        vv_kernels::CompareAVX2(l.data(), r.data(), n));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();